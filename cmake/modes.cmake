@@ -22,3 +22,8 @@ if( USE_PERF_TESTS )
     message( STATUS "Enable performance tests" )
     add_compile_definitions(USE_PERF_TESTS)
 endif( USE_PERF_TESTS )
+
+option(USE_PERF_ALLOCATION_HOOKS OFF)
+if( USE_PERF_ALLOCATION_HOOKS )
+    message( STATUS "Enable allocation hooks in performance tests" )
+endif( USE_PERF_ALLOCATION_HOOKS )
@@ -1,5 +1,7 @@
 option(USE_TBB OFF)
 if( USE_TBB )
+    add_compile_definitions(USE_TBB)
+
     # Build Core OneTBB components
     include_directories(${CMAKE_SOURCE_DIR}/3rdparty/onetbb/include)
 
@@ -1,13 +1,25 @@
 #include <gtest/gtest.h>
 
+#include <algorithm>
 #include <chrono>
+#include <cstddef>
 #include <cstdint>
+#include <filesystem>
+#include <fstream>
 #include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
 #include <vector>
 
 #include "core/perf/func_tests/test_task.hpp"
+#include "core/perf/include/allocation_tracker.hpp"
 #include "core/perf/include/perf.hpp"
+#include "core/perf/include/perf_test.hpp"
+#include "core/perf/include/results_sink.hpp"
+#include "core/task/func_tests/test_task.hpp"
 #include "core/task/include/task.hpp"
+#include "core/util/include/util.hpp"
 
 TEST(perf_tests, check_perf_pipeline) {
   // Create data
@@ -110,6 +122,44 @@ TEST(perf_tests, check_perf_pipeline_uint8_t_slow_test) {
   EXPECT_EQ(out[0], in.size());
 }
 
+TEST(perf_tests, check_perf_soft_time_limit) {
+  // Create data
+  std::vector<uint32_t> in(2000, 1);
+  std::vector<uint32_t> out(1, 0);
+
+  // Create task_data
+  auto task_data = std::make_shared<ppc::core::TaskData>();
+  task_data->inputs.emplace_back(reinterpret_cast<uint8_t *>(in.data()));
+  task_data->inputs_count.emplace_back(in.size());
+  task_data->outputs.emplace_back(reinterpret_cast<uint8_t *>(out.data()));
+  task_data->outputs_count.emplace_back(out.size());
+
+  // Create Task
+  auto test_task = std::make_shared<ppc::test::perf::TestTask<uint32_t>>(task_data);
+
+  // Every running takes one second of the fake timer
+  auto perf_attr = std::make_shared<ppc::core::PerfAttr>();
+  perf_attr->num_running = 3;
+  perf_attr->max_time = 2.0;
+  double fake_time = 0.0;
+  perf_attr->current_timer = [&] { return fake_time += 1.0; };
+
+  // Create and init perf results
+  auto perf_results = std::make_shared<ppc::core::PerfResults>();
+
+  // Create Perf analyzer
+  ppc::core::Perf perf_analyzer(test_task);
+  perf_attr->soft_time_limit = true;
+  perf_analyzer.PipelineRun(perf_attr, perf_results);
+  EXPECT_NO_THROW(ppc::core::Perf::PrintPerfStatistic(perf_results));
+  EXPECT_DOUBLE_EQ(perf_results->time_sec, 3.0);
+  EXPECT_EQ(perf_results->samples_sec.size(), 3U);
+
+  perf_attr->soft_time_limit = false;
+  perf_analyzer.PipelineRun(perf_attr, perf_results);
+  EXPECT_ANY_THROW(ppc::core::Perf::PrintPerfStatistic(perf_results));
+}
+
 TEST(perf_tests, check_perf_task) {
   // Create data
   std::vector<uint32_t> in(2000, 1);
@@ -175,3 +225,545 @@ TEST(perf_tests, check_perf_task_float) {
   ASSERT_LE(perf_results->time_sec, ppc::core::PerfResults::kMaxTime);
   EXPECT_EQ(out[0], in.size());
 }
+
+TEST(perf_tests, check_perf_pipeline_statistic) {
+  // Create data
+  std::vector<uint32_t> in(2000, 1);
+  std::vector<uint32_t> out(1, 0);
+
+  // Create task_data
+  auto task_data = std::make_shared<ppc::core::TaskData>();
+  task_data->inputs.emplace_back(reinterpret_cast<uint8_t *>(in.data()));
+  task_data->inputs_count.emplace_back(in.size());
+  task_data->outputs.emplace_back(reinterpret_cast<uint8_t *>(out.data()));
+  task_data->outputs_count.emplace_back(out.size());
+
+  // Create Task
+  auto test_task = std::make_shared<ppc::test::perf::TestTask<uint32_t>>(task_data);
+
+  // Create Perf attributes with timer which makes every next running 0.1 sec longer
+  auto perf_attr = std::make_shared<ppc::core::PerfAttr>();
+  perf_attr->num_running = 4;
+  double fake_time = 0.0;
+  double fake_step = 0.0;
+  perf_attr->current_timer = [&] {
+    fake_step += 0.1;
+    fake_time += fake_step;
+    return fake_time;
+  };
+
+  // Create and init perf results
+  auto perf_results = std::make_shared<ppc::core::PerfResults>();
+
+  // Create Perf analyzer
+  ppc::core::Perf perf_analyzer(test_task);
+  perf_analyzer.PipelineRun(perf_attr, perf_results);
+
+  // Get perf statistic
+  ASSERT_EQ(perf_results->samples_sec.size(), perf_attr->num_running);
+  EXPECT_NEAR(perf_results->time_sec, 1.4, 1e-9);
+  EXPECT_NEAR(perf_results->min_sec, 0.2, 1e-9);
+  EXPECT_NEAR(perf_results->median_sec, 0.35, 1e-9);
+  EXPECT_NEAR(perf_results->p90_sec, 0.47, 1e-9);
+  EXPECT_NEAR(perf_results->p99_sec, 0.497, 1e-9);
+  EXPECT_NEAR(perf_results->max_sec, 0.5, 1e-9);
+  EXPECT_NEAR(perf_results->mean_sec, 0.35, 1e-9);
+  EXPECT_NEAR(perf_results->stddev_sec, 0.1290994449, 1e-9);
+
+  testing::internal::CaptureStdout();
+  ppc::core::Perf::PrintPerfStatistic(perf_results, ppc::core::Perf::kMachineReadable);
+  auto output = testing::internal::GetCapturedStdout();
+  EXPECT_NE(output.find(":pipeline:statistic:count=4;min=0.2000000000;median=0.3500000000"), std::string::npos);
+  EXPECT_NE(output.find(":pipeline:1.4000000000"), std::string::npos);
+}
+
+TEST(perf_tests, check_perf_task_statistic) {
+  // Create data
+  std::vector<uint32_t> in(2000, 1);
+  std::vector<uint32_t> out(1, 0);
+
+  // Create task_data
+  auto task_data = std::make_shared<ppc::core::TaskData>();
+  task_data->inputs.emplace_back(reinterpret_cast<uint8_t *>(in.data()));
+  task_data->inputs_count.emplace_back(in.size());
+  task_data->outputs.emplace_back(reinterpret_cast<uint8_t *>(out.data()));
+  task_data->outputs_count.emplace_back(out.size());
+
+  // Create Task
+  auto test_task = std::make_shared<ppc::test::perf::TestTask<uint32_t>>(task_data);
+
+  // Create Perf attributes
+  auto perf_attr = std::make_shared<ppc::core::PerfAttr>();
+  perf_attr->num_running = 10;
+  const auto t0 = std::chrono::high_resolution_clock::now();
+  perf_attr->current_timer = [&] {
+    auto current_time_point = std::chrono::high_resolution_clock::now();
+    auto duration = std::chrono::duration_cast<std::chrono::nanoseconds>(current_time_point - t0).count();
+    return static_cast<double>(duration) * 1e-9;
+  };
+
+  // Create and init perf results
+  auto perf_results = std::make_shared<ppc::core::PerfResults>();
+
+  // Create Perf analyzer
+  ppc::core::Perf perf_analyzer(test_task);
+  perf_analyzer.TaskRun(perf_attr, perf_results);
+
+  // Get perf statistic
+  ppc::core::Perf::PrintPerfStatistic(perf_results, ppc::core::Perf::kMachineReadable);
+  ASSERT_EQ(perf_results->samples_sec.size(), perf_attr->num_running);
+  EXPECT_LE(perf_results->min_sec, perf_results->median_sec);
+  EXPECT_LE(perf_results->median_sec, perf_results->p90_sec);
+  EXPECT_LE(perf_results->p90_sec, perf_results->p99_sec);
+  EXPECT_LE(perf_results->p99_sec, perf_results->max_sec);
+  EXPECT_LE(perf_results->max_sec, perf_results->time_sec);
+}
+
+TEST(perf_tests, check_perf_pipeline_warmup_is_not_measured) {
+  // Create data
+  std::vector<uint32_t> in(2000, 1);
+  std::vector<uint32_t> out(1, 0);
+
+  // Create task_data
+  auto task_data = std::make_shared<ppc::core::TaskData>();
+  task_data->inputs.emplace_back(reinterpret_cast<uint8_t *>(in.data()));
+  task_data->inputs_count.emplace_back(in.size());
+  task_data->outputs.emplace_back(reinterpret_cast<uint8_t *>(out.data()));
+  task_data->outputs_count.emplace_back(out.size());
+
+  // Create Task
+  auto test_task = std::make_shared<ppc::test::perf::TestTask<uint32_t>>(task_data);
+
+  // Create Perf attributes with timer which counts its calls
+  auto perf_attr = std::make_shared<ppc::core::PerfAttr>();
+  perf_attr->num_running = 5;
+  perf_attr->num_warmup = 3;
+  uint64_t timer_calls = 0;
+  perf_attr->current_timer = [&] { return static_cast<double>(++timer_calls); };
+
+  // Create and init perf results
+  auto perf_results = std::make_shared<ppc::core::PerfResults>();
+
+  // Create Perf analyzer
+  ppc::core::Perf perf_analyzer(test_task);
+  perf_analyzer.PipelineRun(perf_attr, perf_results);
+
+  // Get perf statistic
+  EXPECT_EQ(timer_calls, perf_attr->num_running + 1);
+  EXPECT_EQ(perf_results->samples_sec.size(), perf_attr->num_running);
+  EXPECT_NEAR(perf_results->time_sec, 5.0, 1e-9);
+  EXPECT_EQ(out[0], in.size());
+}
+
+TEST(perf_tests, check_perf_adaptive_stops_on_stable_time) {
+  // Create data
+  std::vector<uint32_t> in(2000, 1);
+  std::vector<uint32_t> out(1, 0);
+
+  // Create task_data
+  auto task_data = std::make_shared<ppc::core::TaskData>();
+  task_data->inputs.emplace_back(reinterpret_cast<uint8_t *>(in.data()));
+  task_data->inputs_count.emplace_back(in.size());
+  task_data->outputs.emplace_back(reinterpret_cast<uint8_t *>(out.data()));
+  task_data->outputs_count.emplace_back(out.size());
+
+  // Create Task
+  auto test_task = std::make_shared<ppc::test::perf::TestTask<uint32_t>>(task_data);
+
+  // Create Perf attributes with timer which makes every running 0.01 sec long
+  auto perf_attr = std::make_shared<ppc::core::PerfAttr>();
+  perf_attr->num_running = 1;
+  perf_attr->adaptive = true;
+  perf_attr->target_relative_error = 0.01;
+  perf_attr->time_budget = 100.0;
+  double fake_time = 0.0;
+  perf_attr->current_timer = [&] {
+    fake_time += 0.01;
+    return fake_time;
+  };
+
+  // Create and init perf results
+  auto perf_results = std::make_shared<ppc::core::PerfResults>();
+
+  // Create Perf analyzer
+  ppc::core::Perf perf_analyzer(test_task);
+  perf_analyzer.TaskRun(perf_attr, perf_results);
+
+  // Get perf statistic
+  EXPECT_GT(perf_results->samples_sec.size(), perf_attr->num_running);
+  EXPECT_LT(perf_results->samples_sec.size(), 100U);
+  EXPECT_LE(perf_results->median_relative_error, perf_attr->target_relative_error);
+  EXPECT_NEAR(perf_results->median_sec, 0.01, 1e-9);
+}
+
+TEST(perf_tests, check_perf_adaptive_stops_on_time_budget) {
+  // Create data
+  std::vector<uint32_t> in(2000, 1);
+  std::vector<uint32_t> out(1, 0);
+
+  // Create task_data
+  auto task_data = std::make_shared<ppc::core::TaskData>();
+  task_data->inputs.emplace_back(reinterpret_cast<uint8_t *>(in.data()));
+  task_data->inputs_count.emplace_back(in.size());
+  task_data->outputs.emplace_back(reinterpret_cast<uint8_t *>(out.data()));
+  task_data->outputs_count.emplace_back(out.size());
+
+  // Create Task
+  auto test_task = std::make_shared<ppc::test::perf::TestTask<uint32_t>>(task_data);
+
+  // Create Perf attributes with timer which makes runnings from 0.01 to 0.03 sec long
+  auto perf_attr = std::make_shared<ppc::core::PerfAttr>();
+  perf_attr->num_running = 10;
+  perf_attr->adaptive = true;
+  perf_attr->target_relative_error = 0.0;
+  perf_attr->time_budget = 2.0;
+  double fake_time = 0.0;
+  uint64_t timer_calls = 0;
+  perf_attr->current_timer = [&] {
+    fake_time += 0.01 + (0.02 * static_cast<double>(++timer_calls % 13) / 13.0);
+    return fake_time;
+  };
+
+  // Create and init perf results
+  auto perf_results = std::make_shared<ppc::core::PerfResults>();
+
+  // Create Perf analyzer
+  ppc::core::Perf perf_analyzer(test_task);
+  perf_analyzer.PipelineRun(perf_attr, perf_results);
+
+  // Get perf statistic
+  EXPECT_GT(perf_results->samples_sec.size(), perf_attr->num_running);
+  EXPECT_GE(perf_results->time_sec, perf_attr->time_budget);
+  EXPECT_LT(perf_results->time_sec, perf_attr->time_budget + 0.1);
+  EXPECT_GT(perf_results->median_relative_error, perf_attr->target_relative_error);
+  EXPECT_EQ(out[0], in.size());
+}
+
+TEST(perf_tests, check_perf_counters_degrade_gracefully) {
+  // Create data
+  std::vector<uint32_t> in(2000, 1);
+  std::vector<uint32_t> out(1, 0);
+
+  // Create task_data
+  auto task_data = std::make_shared<ppc::core::TaskData>();
+  task_data->inputs.emplace_back(reinterpret_cast<uint8_t *>(in.data()));
+  task_data->inputs_count.emplace_back(in.size());
+  task_data->outputs.emplace_back(reinterpret_cast<uint8_t *>(out.data()));
+  task_data->outputs_count.emplace_back(out.size());
+
+  // Create Task
+  auto test_task = std::make_shared<ppc::test::perf::TestTask<uint32_t>>(task_data);
+
+  // Create Perf attributes
+  auto perf_attr = std::make_shared<ppc::core::PerfAttr>();
+  perf_attr->num_running = 10;
+  perf_attr->collect_counters = true;
+
+  // Create and init perf results
+  auto perf_results = std::make_shared<ppc::core::PerfResults>();
+
+  // Create Perf analyzer
+  ppc::core::Perf perf_analyzer(test_task);
+  ASSERT_NO_THROW(perf_analyzer.PipelineRun(perf_attr, perf_results));
+
+  // Counters may be unavailable (e.g. in a container), but never garbage
+  const auto &counters = perf_results->counters;
+  for (uint8_t event = 0; event < ppc::core::PerfCounters::kNumEvents; event++) {
+    if (!counters.available[event]) {
+      EXPECT_EQ(counters.values[event], 0U);
+    }
+  }
+  if (counters.available[ppc::core::PerfCounters::kInstructions]) {
+    EXPECT_GT(counters.values[ppc::core::PerfCounters::kInstructions], in.size());
+  }
+  ppc::core::Perf::PrintPerfStatistic(perf_results, ppc::core::Perf::kMachineReadable);
+  EXPECT_EQ(out[0], in.size());
+}
+
+TEST(perf_tests, check_perf_reports_scratch_high_water_mark) {
+  // Create data
+  std::vector<uint32_t> in(2000, 1);
+  std::vector<uint32_t> out(1, 0);
+
+  // Create task_data
+  auto task_data = std::make_shared<ppc::core::TaskData>();
+  task_data->inputs.emplace_back(reinterpret_cast<uint8_t *>(in.data()));
+  task_data->inputs_count.emplace_back(in.size());
+  task_data->outputs.emplace_back(reinterpret_cast<uint8_t *>(out.data()));
+  task_data->outputs_count.emplace_back(out.size());
+
+  // Create Task
+  auto test_task = std::make_shared<ppc::test::task::ScratchTask<uint32_t>>(task_data);
+
+  // Create Perf attributes
+  auto perf_attr = std::make_shared<ppc::core::PerfAttr>();
+  perf_attr->num_running = 10;
+
+  // Create and init perf results
+  auto perf_results = std::make_shared<ppc::core::PerfResults>();
+
+  // Create Perf analyzer
+  ppc::core::Perf perf_analyzer(test_task);
+  perf_analyzer.PipelineRun(perf_attr, perf_results);
+  EXPECT_EQ(perf_results->scratch_high_water_bytes, in.size() * sizeof(uint32_t));
+  ppc::core::Perf::PrintPerfStatistic(perf_results, ppc::core::Perf::kMachineReadable);
+}
+
+TEST(perf_tests, check_perf_times_every_phase) {
+  // Create data
+  std::vector<uint32_t> in(2000, 1);
+  std::vector<uint32_t> out(1, 0);
+
+  // Create task_data
+  auto task_data = std::make_shared<ppc::core::TaskData>();
+  task_data->inputs.emplace_back(reinterpret_cast<uint8_t *>(in.data()));
+  task_data->inputs_count.emplace_back(in.size());
+  task_data->outputs.emplace_back(reinterpret_cast<uint8_t *>(out.data()));
+  task_data->outputs_count.emplace_back(out.size());
+
+  // Create Task
+  auto test_task = std::make_shared<ppc::test::perf::SlowPreProcessingTask<uint32_t>>(task_data);
+
+  // Create Perf attributes
+  auto perf_attr = std::make_shared<ppc::core::PerfAttr>();
+  perf_attr->num_running = 5;
+  perf_attr->num_warmup = 1;
+  perf_attr->measure_phases = true;
+
+  // Create and init perf results
+  auto perf_results = std::make_shared<ppc::core::PerfResults>();
+
+  // Create Perf analyzer
+  ppc::core::Perf perf_analyzer(test_task);
+  perf_analyzer.PipelineRun(perf_attr, perf_results);
+  ppc::core::Perf::PrintPerfStatistic(perf_results);
+
+  for (const auto &time : perf_results->phases) {
+    EXPECT_EQ(time.count, perf_attr->num_running);
+    EXPECT_LE(time.min_sec, time.MeanSec());
+    EXPECT_LE(time.MeanSec(), time.max_sec);
+  }
+  const auto &pre_processing = perf_results->phases[static_cast<size_t>(ppc::core::Task::Phase::kPreProcessing)];
+  const auto &run = perf_results->phases[static_cast<size_t>(ppc::core::Task::Phase::kRun)];
+  EXPECT_GE(pre_processing.min_sec, 0.005);
+  EXPECT_GT(pre_processing.total_sec, run.total_sec);
+
+  // Only Run() is timed by TaskRun
+  perf_analyzer.TaskRun(perf_attr, perf_results);
+  EXPECT_EQ(run.count, perf_attr->num_running);
+  EXPECT_EQ(pre_processing.count, 0U);
+
+  // Phases of PipelineRun aren't measured by default
+  perf_attr->measure_phases = false;
+  perf_analyzer.PipelineRun(perf_attr, perf_results);
+  EXPECT_EQ(run.count, 0U);
+}
+
+TEST(perf_tests, check_perf_tracks_allocations_per_phase) {
+  // Create data
+  std::vector<uint32_t> in(2000, 1);
+  std::vector<uint32_t> out(1, 0);
+
+  // Create task_data
+  auto task_data = std::make_shared<ppc::core::TaskData>();
+  task_data->inputs.emplace_back(reinterpret_cast<uint8_t *>(in.data()));
+  task_data->inputs_count.emplace_back(in.size());
+  task_data->outputs.emplace_back(reinterpret_cast<uint8_t *>(out.data()));
+  task_data->outputs_count.emplace_back(out.size());
+
+  // Create Task
+  auto test_task = std::make_shared<ppc::test::perf::AllocatingTask<uint32_t>>(task_data);
+
+  // Create Perf attributes
+  auto perf_attr = std::make_shared<ppc::core::PerfAttr>();
+  perf_attr->num_running = 10;
+  perf_attr->measure_phases = true;
+
+  // Create and init perf results
+  auto perf_results = std::make_shared<ppc::core::PerfResults>();
+
+  // Create Perf analyzer
+  ppc::core::Perf perf_analyzer(test_task);
+  perf_analyzer.PipelineRun(perf_attr, perf_results);
+  ppc::core::Perf::PrintPerfStatistic(perf_results);
+
+  ASSERT_TRUE(ppc::core::AllocationTracker::IsInstalled());
+  const auto &run = perf_results->allocations[static_cast<size_t>(ppc::core::Task::Phase::kRun)];
+  EXPECT_GE(run.count, 2 * perf_attr->num_running);
+  EXPECT_GE(run.bytes, perf_attr->num_running * in.size() * sizeof(uint32_t));
+  const auto &validation = perf_results->allocations[static_cast<size_t>(ppc::core::Task::Phase::kValidation)];
+  EXPECT_EQ(validation.count, 0U);
+#if defined(__linux__) || defined(__APPLE__)
+  EXPECT_GT(perf_results->peak_rss_bytes, 0U);
+#endif
+}
+
+TEST(perf_tests, check_perf_forbid_run_allocations) {
+  // Create data
+  std::vector<uint32_t> in(2000, 1);
+  std::vector<uint32_t> out(1, 0);
+
+  // Create task_data
+  auto task_data = std::make_shared<ppc::core::TaskData>();
+  task_data->inputs.emplace_back(reinterpret_cast<uint8_t *>(in.data()));
+  task_data->inputs_count.emplace_back(in.size());
+  task_data->outputs.emplace_back(reinterpret_cast<uint8_t *>(out.data()));
+  task_data->outputs_count.emplace_back(out.size());
+
+  // Create Perf attributes, the warm-up lets the scratch arena reach its size
+  auto perf_attr = std::make_shared<ppc::core::PerfAttr>();
+  perf_attr->num_running = 10;
+  perf_attr->num_warmup = 1;
+  perf_attr->forbid_run_allocations = true;
+
+  // Create and init perf results
+  auto perf_results = std::make_shared<ppc::core::PerfResults>();
+
+  // Scratch memory is reused, so Run() doesn't allocate
+  ppc::core::Perf scratch_analyzer(std::make_shared<ppc::test::task::ScratchTask<uint32_t>>(task_data));
+  EXPECT_NO_THROW(scratch_analyzer.TaskRun(perf_attr, perf_results));
+
+  ppc::core::Perf allocating_analyzer(std::make_shared<ppc::test::perf::AllocatingTask<uint32_t>>(task_data));
+  EXPECT_THROW(allocating_analyzer.TaskRun(perf_attr, perf_results), std::runtime_error);
+}
+
+namespace {
+
+std::string ReadFile(const std::filesystem::path &path) {
+  std::ifstream file(path);
+  std::stringstream content;
+  content << file.rdbuf();
+  return content.str();
+}
+
+// Runs the perf test of TestTask with given sink and restores the previous one
+void RunWithSink(const std::shared_ptr<ppc::core::ResultsSink> &sink) {
+  std::vector<uint32_t> in(2000, 1);
+  std::vector<uint32_t> out(1, 0);
+  auto task_data = std::make_shared<ppc::core::TaskData>();
+  task_data->inputs.emplace_back(reinterpret_cast<uint8_t *>(in.data()));
+  task_data->inputs_count.emplace_back(in.size());
+  task_data->outputs.emplace_back(reinterpret_cast<uint8_t *>(out.data()));
+  task_data->outputs_count.emplace_back(out.size());
+
+  auto test_task = std::make_shared<ppc::test::perf::TestTask<uint32_t>>(task_data);
+  auto perf_attr = std::make_shared<ppc::core::PerfAttr>();
+  perf_attr->num_running = 3;
+  auto perf_results = std::make_shared<ppc::core::PerfResults>();
+
+  ppc::core::Perf perf_analyzer(test_task);
+  perf_analyzer.PipelineRun(perf_attr, perf_results);
+
+  const auto previous_sink = ppc::core::GetResultsSink();
+  ppc::core::SetResultsSink(sink);
+  ppc::core::Perf::PrintPerfStatistic(perf_results);
+  ppc::core::SetResultsSink(previous_sink);
+}
+
+}  // namespace
+
+TEST(perf_tests, check_jsonl_record_of_perf_test) {
+  const auto path = std::filesystem::temp_directory_path() / "ppc_results_sink_test.jsonl";
+  std::filesystem::remove(path);
+
+  RunWithSink(std::make_shared<ppc::core::JsonlResultsSink>(path.string()));
+  RunWithSink(std::make_shared<ppc::core::JsonlResultsSink>(path.string()));
+
+  const auto content = ReadFile(path);
+  std::filesystem::remove(path);
+  std::stringstream lines(content);
+  std::string line;
+  int num_lines = 0;
+  while (std::getline(lines, line)) {
+    num_lines++;
+    EXPECT_EQ(line.front(), '{');
+    EXPECT_EQ(line.back(), '}');
+    EXPECT_NE(line.find(R"("path":"modules/core/perf/func_tests")"), std::string::npos);
+    EXPECT_NE(line.find(R"("task":"func_tests","backend":"perf","type_of_running":"pipeline")"), std::string::npos);
+    EXPECT_NE(line.find(R"("samples_sec":[)"), std::string::npos);
+    EXPECT_NE(line.find(R"("phase_mean_sec":{"validation":)"), std::string::npos);
+    EXPECT_NE(line.find(R"("git_revision":)"), std::string::npos);
+  }
+  EXPECT_EQ(num_lines, 2);
+}
+
+TEST(perf_tests, check_csv_header_is_written_once) {
+  const auto path = std::filesystem::temp_directory_path() / "ppc_results_sink_test.csv";
+  std::filesystem::remove(path);
+
+  RunWithSink(std::make_shared<ppc::core::CsvResultsSink>(path.string()));
+  RunWithSink(std::make_shared<ppc::core::CsvResultsSink>(path.string()));
+
+  std::ifstream file(path);
+  std::vector<std::string> rows;
+  for (std::string row; std::getline(file, row);) {
+    rows.push_back(row);
+  }
+  file.close();
+  std::filesystem::remove(path);
+
+  ASSERT_EQ(rows.size(), 3U);
+  EXPECT_EQ(rows[0].rfind("path,task,backend,type_of_running,problem_size,num_threads,num_processes", 0), 0U);
+  EXPECT_EQ(rows[1].rfind("modules/core/perf/func_tests,func_tests,perf,pipeline,0,", 0), 0U);
+  EXPECT_EQ(rows[2].rfind("modules/core/perf/func_tests,func_tests,perf,pipeline,0,", 0), 0U);
+}
+
+TEST(perf_tests, check_record_of_task_path) {
+  ppc::core::PerfResults perf_results;
+  perf_results.time_sec = 1.5;
+  perf_results.samples_sec = {0.5, 1.0};
+  perf_results.problem_size = 1000;
+  perf_results.phases[static_cast<size_t>(ppc::core::Task::Phase::kRun)] = {
+      .count = 2, .total_sec = 1.0, .min_sec = 0.4, .max_sec = 0.6};
+
+  const auto record = ppc::core::PerfRecord::Make("tasks/seq/example", "task_run", perf_results);
+  EXPECT_EQ(record.task, "example");
+  EXPECT_EQ(record.backend, "seq");
+  EXPECT_EQ(record.type_of_running, "task_run");
+  EXPECT_EQ(record.problem_size, 1000U);
+  EXPECT_DOUBLE_EQ(record.time_sec, 1.5);
+  EXPECT_EQ(record.samples_sec.size(), 2U);
+  EXPECT_DOUBLE_EQ(record.phase_mean_sec[static_cast<size_t>(ppc::core::Task::Phase::kRun)], 0.5);
+  EXPECT_GE(record.num_processes, 1);
+  EXPECT_FALSE(record.git_revision.empty());
+}
+
+TEST(perf_tests, check_perf_test_case_runs_every_size) {
+  const auto path = std::filesystem::temp_directory_path() / "ppc_perf_test_case.jsonl";
+  std::filesystem::remove(path);
+
+  ppc::core::PerfTestCase<ppc::test::perf::TestTask<uint32_t>, uint32_t> test_case;
+  test_case.sizes = {100, 1000};
+  test_case.generate = [](size_t size) { return std::vector<uint32_t>(size, 1); };
+  test_case.output_count = [](const std::vector<uint32_t> &) { return size_t{1}; };
+  test_case.check = [](const std::vector<uint32_t> &in, const std::vector<uint32_t> &out) {
+    return out[0] == in.size();
+  };
+  test_case.num_running = 3;
+
+  const auto previous_sink = ppc::core::GetResultsSink();
+  ppc::core::SetResultsSink(std::make_shared<ppc::core::JsonlResultsSink>(path.string()));
+  ppc::core::RunPerfTest(test_case, ppc::core::PerfResults::kPipeline);
+  ppc::core::SetResultsSink(previous_sink);
+
+  const auto content = ReadFile(path);
+  std::filesystem::remove(path);
+  const auto sizes = ppc::core::GetPerfSizes("perf_tests", test_case.sizes);
+  for (const auto size : sizes) {
+    EXPECT_NE(content.find(R"("problem_size":)" + std::to_string(ppc::util::ScaledPerfSize(size, 1.0)) + ","),
+              std::string::npos);
+  }
+  EXPECT_EQ(std::count(content.begin(), content.end(), '\n'), static_cast<std::ptrdiff_t>(sizes.size()));
+}
+
+TEST(perf_tests, check_perf_sizes_are_set_per_suite) {
+#ifndef _WIN32
+  setenv("PPC_PERF_SIZES_SUM_OF_ONES", "3,5", 1);  // NOLINT(misc-include-cleaner)
+  EXPECT_EQ(ppc::core::GetPerfSizes("sum_of_ones", {7}), (std::vector<size_t>{3, 5}));
+  EXPECT_EQ(ppc::core::GetPerfSizes("matmul", {7}), (std::vector<size_t>{7}));
+  unsetenv("PPC_PERF_SIZES_SUM_OF_ONES");  // NOLINT(misc-include-cleaner)
+  EXPECT_EQ(ppc::core::GetPerfSizes("sum_of_ones", {7}), (std::vector<size_t>{7}));
+#else
+  GTEST_SKIP();
+#endif
+}
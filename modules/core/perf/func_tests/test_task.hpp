@@ -2,6 +2,7 @@
 
 #include <chrono>
 #include <memory>
+#include <span>
 #include <thread>
 #include <vector>
 
@@ -15,17 +16,17 @@ class TestTask : public ppc::core::Task {
   explicit TestTask(const ppc::core::TaskDataPtr &task_data) : Task(task_data) {}
 
   bool PreProcessingImpl() override {
-    input_ = reinterpret_cast<T *>(task_data->inputs[0]);
-    output_ = reinterpret_cast<T *>(task_data->outputs[0]);
+    input_ = task_data->Input<T>(0);
+    output_ = task_data->Output<T>(0);
     output_[0] = 0;
     return true;
   }
 
-  bool ValidationImpl() override { return task_data->outputs_count[0] == 1; }
+  bool ValidationImpl() override { return task_data->Output<T>(0).size() == 1; }
 
   bool RunImpl() override {
-    for (unsigned i = 0; i < task_data->inputs_count[0]; i++) {
-      output_[0] += input_[i];
+    for (const auto &value : input_) {
+      output_[0] += value;
     }
     return true;
   }
@@ -33,8 +34,8 @@ class TestTask : public ppc::core::Task {
   bool PostProcessingImpl() override { return true; }
 
  private:
-  T *input_{};
-  T *output_{};
+  std::span<const T> input_;
+  std::span<T> output_;
 };
 
 template <class T>
@@ -48,4 +49,33 @@ class FakePerfTask : public TestTask<T> {
   }
 };
 
+// Spends most of the pipeline time in PreProcessing()
+template <class T>
+class SlowPreProcessingTask : public TestTask<T> {
+ public:
+  explicit SlowPreProcessingTask(ppc::core::TaskDataPtr perf_task_data) : TestTask<T>(perf_task_data) {}
+
+  bool PreProcessingImpl() override {
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    return TestTask<T>::PreProcessingImpl();
+  }
+};
+
+// Sums a heap copy of the input made by every Run()
+template <class T>
+class AllocatingTask : public TestTask<T> {
+ public:
+  explicit AllocatingTask(ppc::core::TaskDataPtr perf_task_data) : TestTask<T>(perf_task_data) {}
+
+  bool RunImpl() override {
+    const auto input = this->task_data->template Input<T>(0);
+    auto copy = std::make_unique<std::vector<T>>(input.begin(), input.end());
+    auto output = this->task_data->template Output<T>(0);
+    for (const auto &value : *copy) {
+      output[0] += value;
+    }
+    return true;
+  }
+};
+
 }  // namespace ppc::test::perf
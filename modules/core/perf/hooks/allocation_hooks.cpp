@@ -0,0 +1,80 @@
+// Replacements of global operator new and delete which feed AllocationTracker.
+// This file is not a part of core_module_lib, it is compiled into executables
+// which need allocation tracking (perf tests), so other executables keep the
+// allocator of the standard library. Array and nothrow forms of the standard
+// library call these ones.
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+#include "core/perf/include/allocation_tracker.hpp"
+
+namespace {
+
+[[maybe_unused]] const bool kInstalled = [] {
+  ppc::core::AllocationTracker::MarkInstalled();
+  return true;
+}();
+
+void *Allocate(size_t size) {
+  ppc::core::AllocationTracker::RecordAllocation(size);
+  while (true) {
+    if (void *ptr = std::malloc(size == 0 ? 1 : size)) {
+      return ptr;
+    }
+    if (auto handler = std::get_new_handler()) {
+      handler();
+    } else {
+      throw std::bad_alloc();
+    }
+  }
+}
+
+void *AllocateAligned(size_t size, std::align_val_t alignment) {
+  ppc::core::AllocationTracker::RecordAllocation(size);
+  const auto align = std::max(static_cast<size_t>(alignment), sizeof(void *));
+  while (true) {
+#ifdef _WIN32
+    void *ptr = _aligned_malloc(size == 0 ? 1 : size, align);
+#else
+    void *ptr = nullptr;
+    if (posix_memalign(&ptr, align, size == 0 ? 1 : size) != 0) {
+      ptr = nullptr;
+    }
+#endif
+    if (ptr != nullptr) {
+      return ptr;
+    }
+    if (auto handler = std::get_new_handler()) {
+      handler();
+    } else {
+      throw std::bad_alloc();
+    }
+  }
+}
+
+void FreeAligned(void *ptr) {
+#ifdef _WIN32
+  _aligned_free(ptr);
+#else
+  std::free(ptr);
+#endif
+}
+
+}  // namespace
+
+void *operator new(size_t size) { return Allocate(size); }
+void *operator new[](size_t size) { return Allocate(size); }
+void *operator new(size_t size, std::align_val_t alignment) { return AllocateAligned(size, alignment); }
+void *operator new[](size_t size, std::align_val_t alignment) { return AllocateAligned(size, alignment); }
+
+void operator delete(void *ptr) noexcept { std::free(ptr); }
+void operator delete[](void *ptr) noexcept { std::free(ptr); }
+void operator delete(void *ptr, size_t /*size*/) noexcept { std::free(ptr); }
+void operator delete[](void *ptr, size_t /*size*/) noexcept { std::free(ptr); }
+void operator delete(void *ptr, std::align_val_t /*alignment*/) noexcept { FreeAligned(ptr); }
+void operator delete[](void *ptr, std::align_val_t /*alignment*/) noexcept { FreeAligned(ptr); }
+void operator delete(void *ptr, size_t /*size*/, std::align_val_t /*alignment*/) noexcept { FreeAligned(ptr); }
+void operator delete[](void *ptr, size_t /*size*/, std::align_val_t /*alignment*/) noexcept { FreeAligned(ptr); }
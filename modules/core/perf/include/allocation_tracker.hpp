@@ -0,0 +1,34 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace ppc::core {
+
+struct AllocationStats {
+  // number of calls of global operator new
+  uint64_t count = 0;
+  // requested bytes of these calls
+  uint64_t bytes = 0;
+};
+
+// Counters of global operator new of the process. They are updated only by
+// replacements of operator new from core/perf/hooks/allocation_hooks.cpp, which
+// are compiled into core tests and into perf tests of tasks with
+// USE_PERF_ALLOCATION_HOOKS=ON. Other executables have IsInstalled() == false
+// and zero counters. Allocations of all threads are counted.
+class AllocationTracker {
+ public:
+  [[nodiscard]] static bool IsInstalled();
+  // Totals since the start of the process
+  [[nodiscard]] static AllocationStats Snapshot();
+  // Peak resident set size of the process, it doesn't need the hooks (Linux and
+  // macOS only, 0 on other systems)
+  [[nodiscard]] static uint64_t PeakRssBytes();
+
+  // Interface of the hooks
+  static void MarkInstalled();
+  static void RecordAllocation(size_t bytes);
+};
+
+}  // namespace ppc::core
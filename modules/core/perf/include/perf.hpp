@@ -1,9 +1,13 @@
 #pragma once
 
+#include <array>
 #include <cstdint>
 #include <functional>
 #include <memory>
+#include <vector>
 
+#include "core/perf/include/allocation_tracker.hpp"
+#include "core/perf/include/perf_counters.hpp"
 #include "core/task/include/task.hpp"
 
 namespace ppc::core {
@@ -11,18 +15,85 @@ namespace ppc::core {
 struct PerfAttr {
   // count of task's running
   uint64_t num_running;
+  // count of task's running before measurement, their time is discarded
+  uint64_t num_warmup = 0;
+  // keep running after num_running until the 95% confidence interval of the
+  // median is narrower than target_relative_error or time_budget is spent
+  bool adaptive = false;
+  double target_relative_error = 0.05;
+  // time budget of adaptive running (in seconds)
+  double time_budget = 5.0;
+  // collect hardware counters of the measured runnings (Linux only)
+  bool collect_counters = false;
+  // fail if Run() allocates during the measured runnings, buffers which grow
+  // lazily on the first Run() need num_warmup > 0 (needs allocation hooks)
+  bool forbid_run_allocations = false;
+  // time and allocations of every phase of PipelineRun (PerfResults::phases),
+  // it adds clock reads inside the measured runnings, so it's off by default
+  bool measure_phases = false;
+  // limit of the measured time (in seconds), 0 takes PPC_PERF_MAX_TIME or
+  // PerfResults::kMaxTime. An overrun of a soft limit is reported with the full
+  // statistic instead of an exception, PPC_SOFT_TIME_LIMITS=1 makes all limits soft
+  double max_time = 0.0;
+  bool soft_time_limit = false;
   std::function<double()> current_timer = [&] { return 0.0; };
 };
 
+// Time of one phase of the task over the measured runnings, steady clock time
+// of every phase for PipelineRun and the measured time of Run() for TaskRun
+struct PhaseStats {
+  uint64_t count = 0;
+  // (in seconds)
+  double total_sec = 0.0;
+  double min_sec = 0.0;
+  double max_sec = 0.0;
+
+  [[nodiscard]] double MeanSec() const { return count > 0 ? total_sec / static_cast<double>(count) : 0.0; }
+};
+
 struct PerfResults {
   // measurement of task's time (in seconds)
   double time_sec = 0.0;
+  // time of every single running (in seconds)
+  std::vector<double> samples_sec;
+  // distribution of single running time (in seconds)
+  double min_sec = 0.0;
+  double median_sec = 0.0;
+  double p90_sec = 0.0;
+  double p99_sec = 0.0;
+  double max_sec = 0.0;
+  double mean_sec = 0.0;
+  double stddev_sec = 0.0;
+  // relative half-width of the 95% confidence interval of the median
+  double median_relative_error = 0.0;
+  // hardware counters of all measured runnings
+  PerfCounters counters;
+  // the largest amount of scratch memory used by one run of the task (in bytes)
+  uint64_t scratch_high_water_bytes = 0;
+  // allocations of every phase of the measured runnings, indexed by
+  // Task::Phase, only Run() is measured by Perf::TaskRun and PipelineRun
+  // measures them with PerfAttr::measure_phases or forbid_run_allocations
+  std::array<AllocationStats, 4> allocations{};
+  // peak resident set size of the process after the measured runnings (in
+  // bytes, Linux and macOS only), it isn't split between phases
+  uint64_t peak_rss_bytes = 0;
+  // time of every phase of the measured runnings, indexed by Task::Phase, it
+  // shows whether copying of inputs in PreProcessing() outweighs Run(). It's
+  // filled by PipelineRun with PerfAttr::measure_phases and always by TaskRun
+  std::array<PhaseStats, 4> phases{};
   enum TypeOfRunning : uint8_t { kPipeline, kTaskRun, kNone } type_of_running = kNone;
+  // size of the problem of the test if it is benchmarked for several sizes
+  uint64_t problem_size = 0;
+  // limit of time_sec checked by Perf::PrintPerfStatistic, taken from PerfAttr
+  double max_time_sec = kMaxTime;
+  bool soft_time_limit = false;
   constexpr static double kMaxTime = 10.0;
 };
 
 class Perf {
  public:
+  // Output format of performance statistic
+  enum PrintMode : uint8_t { kDefault, kMachineReadable };
   // Init performance analysis with initialized task and initialized data
   explicit Perf(const std::shared_ptr<Task>& task_ptr);
   // Set task with initialized task and initialized data for performance
@@ -33,8 +104,9 @@ class Perf {
   void PipelineRun(const std::shared_ptr<PerfAttr>& perf_attr, const std::shared_ptr<PerfResults>& perf_results) const;
   // Check performance of task's Run() function
   void TaskRun(const std::shared_ptr<PerfAttr>& perf_attr, const std::shared_ptr<PerfResults>& perf_results) const;
-  // Pint results for automation checkers
-  static void PrintPerfStatistic(const std::shared_ptr<PerfResults>& perf_results);
+  // Pint results for automation checkers, kMachineReadable additionally
+  // prints the distribution of single running time and available counters
+  static void PrintPerfStatistic(const std::shared_ptr<PerfResults>& perf_results, PrintMode mode = kDefault);
 
  private:
   std::shared_ptr<Task> task_;
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+namespace ppc::core {
+
+struct PerfCounters {
+  enum Event : uint8_t { kCycles, kInstructions, kL1dMisses, kLlcMisses, kBranchMisses, kContextSwitches, kNumEvents };
+  // value of every counter for the whole measurement, valid only if available
+  std::array<uint64_t, kNumEvents> values{};
+  std::array<bool, kNumEvents> available{};
+
+  static const char* Name(Event event);
+  [[nodiscard]] bool AnyAvailable() const;
+};
+
+// Hardware and software counters of the calling process (Linux perf_event_open).
+// Counters which can't be opened (no PMU in container, perf_event_paranoid and
+// so on) are silently marked as unavailable. Threads created after the
+// construction are counted too, already running thread pools are not.
+class HardwareCounters {
+ public:
+  HardwareCounters();
+  HardwareCounters(const HardwareCounters&) = delete;
+  HardwareCounters& operator=(const HardwareCounters&) = delete;
+  ~HardwareCounters();
+
+  void Start();
+  void Stop();
+  // Values scaled by the running time if counters were multiplexed
+  [[nodiscard]] PerfCounters Read() const;
+
+ private:
+  std::array<int, PerfCounters::kNumEvents> fds_{};
+};
+
+}  // namespace ppc::core
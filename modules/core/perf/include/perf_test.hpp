@@ -0,0 +1,120 @@
+#pragma once
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "core/perf/include/perf.hpp"
+#include "core/task/include/task.hpp"
+#include "core/util/include/util.hpp"
+
+namespace ppc::core {
+
+// Timer of perf tests, seconds of the steady clock since the call
+inline std::function<double()> MakeSteadyTimer() {
+  const auto t0 = std::chrono::steady_clock::now();
+  return [t0] { return std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count(); };
+}
+
+// Sizes of perf tests of the suite from PPC_PERF_SIZES_<SUITE> (suite name in
+// upper case, e.g. PPC_PERF_SIZES_NESTEROV_A_TEST_TASK_SEQ="100,1000"),
+// default_sizes if it is not set. Meaning of a size is defined by the suite, so
+// there is no variable shared by all suites
+inline std::vector<size_t> GetPerfSizes(const std::string& suite, const std::vector<size_t>& default_sizes) {
+  std::string name = "PPC_PERF_SIZES_" + suite;
+  std::ranges::transform(name, name.begin(), [](unsigned char c) { return static_cast<char>(std::toupper(c)); });
+  std::stringstream sizes_str(ppc::util::GetEnv(name.c_str()));
+  std::vector<size_t> sizes;
+  for (std::string size; std::getline(sizes_str, size, ',');) {
+    if (const auto value = std::strtoull(size.c_str(), nullptr, 10); value > 0) {
+      sizes.push_back(static_cast<size_t>(value));
+    }
+  }
+  return sizes.empty() ? default_sizes : sizes;
+}
+
+// Description of perf tests of a task: input of every size is made by
+// generate(size), the task is built over it by make_task, output is checked by
+// check(in, out) after every benchmark. Input and output are passed as typed
+// buffers, so the task reads them by TaskData::Input() and Output()
+template <class TaskType, class InType, class OutType = InType>
+struct PerfTestCase {
+  // every size is benchmarked separately, PPC_PERF_SIZES_<SUITE> replaces them
+  std::vector<size_t> sizes;
+  // work of the task grows as size^work_exponent, sizes are scaled by it in
+  // weak scaling runs (see ppc::util::ScaledPerfSize)
+  double work_exponent = 1.0;
+  std::function<std::vector<InType>(size_t size)> generate;
+  std::function<size_t(const std::vector<InType>& in)> output_count = [](const std::vector<InType>& in) {
+    return in.size();
+  };
+  std::function<bool(const std::vector<InType>& in, const std::vector<OutType>& out)> check;
+  std::function<std::shared_ptr<Task>(TaskDataPtr task_data)> make_task = [](TaskDataPtr task_data) {
+    return std::make_shared<TaskType>(std::move(task_data));
+  };
+  // only this process prints results and checks output, e.g. rank 0 of MPI tasks
+  std::function<bool()> is_root = [] { return true; };
+  uint64_t num_running = 10;
+};
+
+// Benchmarks the task for every size of the test case
+template <class TaskType, class InType, class OutType>
+void RunPerfTest(const PerfTestCase<TaskType, InType, OutType>& test_case,
+                 PerfResults::TypeOfRunning type_of_running) {
+  const std::string suite = ::testing::UnitTest::GetInstance()->current_test_info()->test_suite_name();
+  for (const auto base_size : GetPerfSizes(suite, test_case.sizes)) {
+    const auto size = ppc::util::ScaledPerfSize(base_size, test_case.work_exponent);
+
+    // Create data
+    auto in = test_case.generate(size);
+    std::vector<OutType> out(test_case.output_count(in));
+
+    // Create task_data, counts of typed buffers are 64-bit, so large sizes are
+    // not truncated
+    auto task_data = std::make_shared<TaskData>();
+    task_data->input_buffers.emplace_back(Buffer::Borrow(in.data(), in.size()));
+    task_data->output_buffers.emplace_back(Buffer::Borrow(out.data(), out.size()));
+
+    // Create Perf attributes and results
+    auto perf_attr = std::make_shared<PerfAttr>();
+    perf_attr->num_running = test_case.num_running;
+    perf_attr->current_timer = MakeSteadyTimer();
+    auto perf_results = std::make_shared<PerfResults>();
+    perf_results->problem_size = size;
+
+    Perf perf_analyzer(test_case.make_task(task_data));
+    if (type_of_running == PerfResults::kPipeline) {
+      perf_analyzer.PipelineRun(perf_attr, perf_results);
+    } else {
+      perf_analyzer.TaskRun(perf_attr, perf_results);
+    }
+    if (test_case.is_root()) {
+      Perf::PrintPerfStatistic(perf_results);
+      EXPECT_TRUE(test_case.check(in, out)) << "Wrong output of size " << size;
+    }
+  }
+}
+
+}  // namespace ppc::core
+
+// Registers test_pipeline_run and test_task_run of the suite, each of them runs
+// all sizes of the test case returned by make_test_case(). Suites of perf tests
+// have exactly these two tests (see scripts/run_perf_counter.py)
+#define PPC_PERF_TESTS(suite, make_test_case)                                        \
+  TEST(suite, test_pipeline_run) {                                                   \
+    ::ppc::core::RunPerfTest(make_test_case(), ::ppc::core::PerfResults::kPipeline); \
+  }                                                                                  \
+  TEST(suite, test_task_run) {                                                       \
+    ::ppc::core::RunPerfTest(make_test_case(), ::ppc::core::PerfResults::kTaskRun);  \
+  }
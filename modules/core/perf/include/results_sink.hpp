@@ -0,0 +1,80 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "core/perf/include/perf.hpp"
+
+namespace ppc::core {
+
+// Structured result of one perf test
+struct PerfRecord {
+  // directory of the test relative to the project, e.g. tasks/seq/example
+  std::string path;
+  // name and backend of the task, e.g. example and seq
+  std::string task;
+  std::string backend;
+  // pipeline or task_run
+  std::string type_of_running;
+  // size of the problem, 0 if the test has one size
+  uint64_t problem_size = 0;
+  int num_threads = 1;
+  int num_processes = 1;
+  // multiplier of the work of the test in weak scaling runs
+  double work_scale = 1.0;
+  // (in seconds)
+  double time_sec = 0.0;
+  double median_sec = 0.0;
+  std::vector<double> samples_sec;
+  // mean time of every phase, indexed by Task::Phase (in seconds)
+  std::array<double, 4> phase_mean_sec{};
+  // placement of threads, empty if threads are not pinned
+  std::string pinning;
+  std::string host;
+  int host_cpus = 0;
+  std::string git_revision;
+
+  // Record of results of the test with given path, the rest is taken from the
+  // environment of the process
+  static PerfRecord Make(const std::string& path, const std::string& type_of_running, const PerfResults& perf_results);
+};
+
+// Destination of records of perf tests
+class ResultsSink {
+ public:
+  virtual ~ResultsSink() = default;
+  virtual void Write(const PerfRecord& record) = 0;
+};
+
+// Appends one JSON object per line
+class JsonlResultsSink : public ResultsSink {
+ public:
+  explicit JsonlResultsSink(std::string path) : path_(std::move(path)) {}
+  void Write(const PerfRecord& record) override;
+
+ private:
+  std::string path_;
+};
+
+// Appends one row per record, the header is written to an empty file. Samples
+// and phases are separated by spaces inside their columns
+class CsvResultsSink : public ResultsSink {
+ public:
+  explicit CsvResultsSink(std::string path) : path_(std::move(path)) {}
+  void Write(const PerfRecord& record) override;
+
+ private:
+  std::string path_;
+};
+
+// Sink used by Perf::PrintPerfStatistic: the one set by SetResultsSink,
+// otherwise a sink to the file from PPC_PERF_RESULTS (CSV for *.csv, JSONL for
+// other names) or nullptr if the variable is not set
+std::shared_ptr<ResultsSink> GetResultsSink();
+void SetResultsSink(std::shared_ptr<ResultsSink> sink);
+
+}  // namespace ppc::core
@@ -0,0 +1,51 @@
+#include "core/perf/include/allocation_tracker.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__linux__) || defined(__APPLE__)
+#include <sys/resource.h>
+#endif
+
+namespace {
+
+// Constant-initialized, so they are ready for allocations of static constructors
+constinit std::atomic<bool> installed{false};
+constinit std::atomic<uint64_t> num_allocations{0};
+constinit std::atomic<uint64_t> num_allocated_bytes{0};
+
+}  // namespace
+
+bool ppc::core::AllocationTracker::IsInstalled() { return installed.load(std::memory_order_relaxed); }
+
+ppc::core::AllocationStats ppc::core::AllocationTracker::Snapshot() {
+  if (!IsInstalled()) {
+    return {};
+  }
+  return {.count = num_allocations.load(std::memory_order_relaxed),
+          .bytes = num_allocated_bytes.load(std::memory_order_relaxed)};
+}
+
+uint64_t ppc::core::AllocationTracker::PeakRssBytes() {
+#if defined(__linux__) || defined(__APPLE__)
+  rusage usage{};
+  if (getrusage(RUSAGE_SELF, &usage) != 0) {
+    return 0;
+  }
+#ifdef __APPLE__
+  return static_cast<uint64_t>(usage.ru_maxrss);
+#else
+  return static_cast<uint64_t>(usage.ru_maxrss) * 1024;
+#endif
+#else
+  return 0;
+#endif
+}
+
+void ppc::core::AllocationTracker::MarkInstalled() { installed.store(true, std::memory_order_relaxed); }
+
+void ppc::core::AllocationTracker::RecordAllocation(size_t bytes) {
+  num_allocations.fetch_add(1, std::memory_order_relaxed);
+  num_allocated_bytes.fetch_add(bytes, std::memory_order_relaxed);
+}
@@ -2,16 +2,134 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
 #include <cstdint>
 #include <functional>
 #include <iomanip>
 #include <iostream>
+#include <limits>
 #include <memory>
+#include <numeric>
+#include <optional>
 #include <sstream>
 #include <stdexcept>
 #include <string>
+#include <vector>
 
+#include "core/perf/include/allocation_tracker.hpp"
+#include "core/perf/include/perf_counters.hpp"
+#include "core/perf/include/results_sink.hpp"
 #include "core/task/include/task.hpp"
+#include "core/util/include/topology.hpp"
+#include "core/util/include/util.hpp"
+
+namespace {
+
+// Linear interpolation between the closest ranks of sorted samples
+double Percentile(const std::vector<double>& sorted_samples, double fraction) {
+  const auto position = fraction * static_cast<double>(sorted_samples.size() - 1);
+  const auto lower = static_cast<size_t>(std::floor(position));
+  const auto upper = std::min(lower + 1, sorted_samples.size() - 1);
+  const auto weight = position - static_cast<double>(lower);
+  return sorted_samples[lower] + (weight * (sorted_samples[upper] - sorted_samples[lower]));
+}
+
+// Relative half-width of the distribution-free 95% confidence interval of the
+// median, bounded by order statistics of sorted samples
+double MedianRelativeError(const std::vector<double>& sorted_samples) {
+  constexpr double kZ = 1.96;
+  constexpr size_t kMinSamples = 6;
+  const auto count = sorted_samples.size();
+  if (count < kMinSamples) {
+    return std::numeric_limits<double>::infinity();
+  }
+
+  // 1-based ranks of the interval bounds
+  const auto middle = static_cast<double>(count) / 2.0;
+  const auto half_width = kZ * std::sqrt(static_cast<double>(count)) / 2.0;
+  const auto lower = static_cast<size_t>(std::max(std::floor(middle - half_width), 1.0));
+  const auto upper = std::min(static_cast<size_t>(std::ceil(1.0 + middle + half_width)), count);
+
+  const auto width = sorted_samples[upper - 1] - sorted_samples[lower - 1];
+  const auto median = Percentile(sorted_samples, 0.5);
+  if (width == 0.0) {
+    return 0.0;
+  }
+  return median > 0.0 ? width / (2.0 * median) : std::numeric_limits<double>::infinity();
+}
+
+double SortedMedianRelativeError(const std::vector<double>& samples, std::vector<double>& sorted_samples) {
+  sorted_samples.assign(samples.begin(), samples.end());
+  std::ranges::sort(sorted_samples);
+  return MedianRelativeError(sorted_samples);
+}
+
+void CalculateStatistic(ppc::core::PerfResults& perf_results) {
+  const auto& samples = perf_results.samples_sec;
+  if (samples.empty()) {
+    perf_results.min_sec = perf_results.median_sec = perf_results.p90_sec = perf_results.p99_sec = 0.0;
+    perf_results.max_sec = perf_results.mean_sec = perf_results.stddev_sec = 0.0;
+    perf_results.median_relative_error = 0.0;
+    return;
+  }
+
+  auto sorted_samples = samples;
+  std::ranges::sort(sorted_samples);
+  perf_results.min_sec = sorted_samples.front();
+  perf_results.median_sec = Percentile(sorted_samples, 0.5);
+  perf_results.p90_sec = Percentile(sorted_samples, 0.9);
+  perf_results.p99_sec = Percentile(sorted_samples, 0.99);
+  perf_results.max_sec = sorted_samples.back();
+  perf_results.median_relative_error = MedianRelativeError(sorted_samples);
+
+  const auto count = static_cast<double>(samples.size());
+  perf_results.mean_sec = std::accumulate(samples.begin(), samples.end(), 0.0) / count;
+
+  double squares_sum = 0.0;
+  for (const auto sample : samples) {
+    squares_sum += (sample - perf_results.mean_sec) * (sample - perf_results.mean_sec);
+  }
+  perf_results.stddev_sec = samples.size() > 1 ? std::sqrt(squares_sum / (count - 1.0)) : 0.0;
+}
+
+// Adds steady clock time and allocations of func to statistic of the phase
+template <class Func>
+void MeasurePhase(ppc::core::PerfResults& perf_results, ppc::core::Task::Phase phase, const Func& func) {
+  const auto allocations_before = ppc::core::AllocationTracker::Snapshot();
+  const auto start = std::chrono::steady_clock::now();
+  func();
+  const auto duration = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  const auto allocations_after = ppc::core::AllocationTracker::Snapshot();
+
+  auto& time = perf_results.phases[static_cast<size_t>(phase)];
+  time.min_sec = time.count > 0 ? std::min(time.min_sec, duration) : duration;
+  time.max_sec = std::max(time.max_sec, duration);
+  time.total_sec += duration;
+  time.count++;
+
+  auto& stats = perf_results.allocations[static_cast<size_t>(phase)];
+  stats.count += allocations_after.count - allocations_before.count;
+  stats.bytes += allocations_after.bytes - allocations_before.bytes;
+}
+
+const char* PhaseKey(ppc::core::Task::Phase phase) {
+  switch (phase) {
+    case ppc::core::Task::Phase::kValidation:
+      return "validation";
+    case ppc::core::Task::Phase::kPreProcessing:
+      return "pre_processing";
+    case ppc::core::Task::Phase::kRun:
+      return "run";
+    case ppc::core::Task::Phase::kPostProcessing:
+      return "post_processing";
+  }
+  return "unknown";
+}
+
+}  // namespace
 
 ppc::core::Perf::Perf(const std::shared_ptr<Task>& task_ptr) { SetTask(task_ptr); }
 
@@ -24,15 +142,29 @@ void ppc::core::Perf::PipelineRun(const std::shared_ptr<PerfAttr>& perf_attr,
                                   const std::shared_ptr<ppc::core::PerfResults>& perf_results) const {
   perf_results->type_of_running = PerfResults::TypeOfRunning::kPipeline;
 
-  CommonRun(
-      perf_attr,
-      [&]() {
-        task_->Validation();
-        task_->PreProcessing();
-        task_->Run();
-        task_->PostProcessing();
-      },
-      perf_results);
+  // Allocations of Run() are separated from other phases only by the phase measurement
+  if (perf_attr->measure_phases || perf_attr->forbid_run_allocations) {
+    CommonRun(
+        perf_attr,
+        [&]() {
+          MeasurePhase(*perf_results, Task::Phase::kValidation, [&] { task_->Validation(); });
+          MeasurePhase(*perf_results, Task::Phase::kPreProcessing, [&] { task_->PreProcessing(); });
+          MeasurePhase(*perf_results, Task::Phase::kRun, [&] { task_->Run(); });
+          MeasurePhase(*perf_results, Task::Phase::kPostProcessing, [&] { task_->PostProcessing(); });
+        },
+        perf_results);
+  } else {
+    CommonRun(
+        perf_attr,
+        [&]() {
+          task_->Validation();
+          task_->PreProcessing();
+          task_->Run();
+          task_->PostProcessing();
+        },
+        perf_results);
+  }
+  perf_results->scratch_high_water_bytes = task_->GetScratch().HighWaterMark();
 }
 
 void ppc::core::Perf::TaskRun(const std::shared_ptr<PerfAttr>& perf_attr,
@@ -43,6 +175,7 @@ void ppc::core::Perf::TaskRun(const std::shared_ptr<PerfAttr>& perf_attr,
   task_->PreProcessing();
   CommonRun(perf_attr, [&]() { task_->Run(); }, perf_results);
   task_->PostProcessing();
+  perf_results->scratch_high_water_bytes = task_->GetScratch().HighWaterMark();
 
   task_->Validation();
   task_->PreProcessing();
@@ -52,15 +185,90 @@ void ppc::core::Perf::TaskRun(const std::shared_ptr<PerfAttr>& perf_attr,
 
 void ppc::core::Perf::CommonRun(const std::shared_ptr<PerfAttr>& perf_attr, const std::function<void()>& pipeline,
                                 const std::shared_ptr<ppc::core::PerfResults>& perf_results) {
-  auto begin = perf_attr->current_timer();
-  for (uint64_t i = 0; i < perf_attr->num_running; i++) {
+  for (uint64_t i = 0; i < perf_attr->num_warmup; i++) {
     pipeline();
   }
+  perf_results->allocations = {};
+  perf_results->phases = {};
+  perf_results->max_time_sec = perf_attr->max_time > 0.0
+                                   ? perf_attr->max_time
+                                   : ppc::util::GetPPCTimeLimit("PPC_PERF_MAX_TIME", PerfResults::kMaxTime);
+  perf_results->soft_time_limit = perf_attr->soft_time_limit || ppc::util::GetPPCSoftTimeLimits();
+
+  auto& samples = perf_results->samples_sec;
+  samples.clear();
+  samples.reserve(perf_attr->num_running);
+  perf_results->time_sec = 0.0;
+
+  std::optional<HardwareCounters> hardware_counters;
+  if (perf_attr->collect_counters) {
+    hardware_counters.emplace();
+    hardware_counters->Start();
+  }
+
+  // Allocations are counted around all measured runnings, so TaskRun doesn't
+  // add work to the time of a single running
+  const auto allocations_before = AllocationTracker::Snapshot();
   auto end = perf_attr->current_timer();
-  perf_results->time_sec = end - begin;
+  auto run_once = [&] {
+    pipeline();
+    auto current = perf_attr->current_timer();
+    samples.push_back(current - end);
+    perf_results->time_sec += current - end;
+    end = current;
+  };
+
+  for (uint64_t i = 0; i < perf_attr->num_running; i++) {
+    run_once();
+  }
+
+  if (perf_attr->adaptive) {
+    std::vector<double> sorted_samples;
+    while (perf_results->time_sec < perf_attr->time_budget &&
+           SortedMedianRelativeError(samples, sorted_samples) > perf_attr->target_relative_error) {
+      // Time of the convergence check is not a part of the next running
+      end = perf_attr->current_timer();
+      run_once();
+    }
+  }
+
+  const auto allocations_after = AllocationTracker::Snapshot();
+
+  perf_results->counters = PerfCounters();
+  if (hardware_counters) {
+    hardware_counters->Stop();
+    perf_results->counters = hardware_counters->Read();
+  }
+  CalculateStatistic(*perf_results);
+
+  // Only Run() is measured by TaskRun, so its phase is the whole measurement
+  if (perf_results->type_of_running == PerfResults::TypeOfRunning::kTaskRun) {
+    auto& run_allocations = perf_results->allocations[static_cast<size_t>(Task::Phase::kRun)];
+    run_allocations.count = allocations_after.count - allocations_before.count;
+    run_allocations.bytes = allocations_after.bytes - allocations_before.bytes;
+    perf_results->phases[static_cast<size_t>(Task::Phase::kRun)] = {.count = samples.size(),
+                                                                     .total_sec = perf_results->time_sec,
+                                                                     .min_sec = perf_results->min_sec,
+                                                                     .max_sec = perf_results->max_sec};
+  }
+  // getrusage() isn't a part of any measured running
+  perf_results->peak_rss_bytes = AllocationTracker::PeakRssBytes();
+
+  if (perf_attr->forbid_run_allocations) {
+    if (!AllocationTracker::IsInstalled()) {
+      throw std::runtime_error("Run() allocations can't be checked: allocation hooks are not linked");
+    }
+    const auto& run_allocations = perf_results->allocations[static_cast<size_t>(Task::Phase::kRun)];
+    if (run_allocations.count > 0) {
+      std::stringstream err_msg;
+      err_msg << '\n' << "Run() must not allocate memory." << '\n';
+      err_msg << "Allocations: " << run_allocations.count << ", bytes: " << run_allocations.bytes << '\n';
+      throw std::runtime_error(err_msg.str());
+    }
+  }
 }
 
-void ppc::core::Perf::PrintPerfStatistic(const std::shared_ptr<PerfResults>& perf_results) {
+void ppc::core::Perf::PrintPerfStatistic(const std::shared_ptr<PerfResults>& perf_results, PrintMode mode) {
   std::string relative_path(::testing::UnitTest::GetInstance()->current_test_info()->file());
   std::string ppc_regex_template("parallel_programming_course");
   std::string perf_regex_template("perf_tests");
@@ -82,17 +290,101 @@ void ppc::core::Perf::PrintPerfStatistic(const std::shared_ptr<PerfResults>& per
   auto last_found_position = relative_path.find(perf_regex_template) - 1;
   relative_path.erase(last_found_position, relative_path.length() - 1);
 
-  std::stringstream perf_res_str;
-  if (time_secs < PerfResults::kMaxTime) {
-    perf_res_str << std::fixed << std::setprecision(10) << time_secs;
-    std::cout << relative_path << ":" << type_test_name << ":" << perf_res_str.str() << '\n';
-  } else {
-    std::stringstream err_msg;
+  if (perf_results->problem_size > 0) {
+    std::cout << relative_path << ":" << type_test_name << ":size:" << perf_results->problem_size << '\n';
+  }
+
+  // Placement of threads explains differences between runs on multi-socket
+  // machines, the line shows the requested placement
+  const auto pinning = ppc::util::DescribePPCPinning();
+  if (!pinning.empty()) {
+    std::cout << relative_path << ":" << type_test_name << ":pinning:" << pinning << '\n';
+  }
+
+  // Share of every phase in the total time of phases, e.g. copying of inputs
+  // in PreProcessing() may take longer than Run()
+  double phases_total_sec = 0.0;
+  bool phases_measured = false;
+  for (const auto& time : perf_results->phases) {
+    phases_total_sec += time.total_sec;
+    phases_measured = phases_measured || time.count > 0;
+  }
+  if (phases_total_sec > 0.0) {
+    std::stringstream phases_str;
+    phases_str << std::fixed << std::setprecision(10);
+    for (size_t phase = 0; phase < perf_results->phases.size(); phase++) {
+      const auto* key = PhaseKey(static_cast<Task::Phase>(phase));
+      const auto& time = perf_results->phases[phase];
+      phases_str << (phase > 0 ? ";" : "") << key << "_mean=" << time.MeanSec() << ";" << key
+                 << "_max=" << time.max_sec << ";" << key << "_share=" << time.total_sec / phases_total_sec;
+    }
+    std::cout << relative_path << ":" << type_test_name << ":phases:" << phases_str.str() << '\n';
+  }
+
+  // Allocations are split between phases only when the phases are measured
+  if (AllocationTracker::IsInstalled() && phases_measured) {
+    std::stringstream allocations_str;
+    for (size_t phase = 0; phase < perf_results->allocations.size(); phase++) {
+      const auto* key = PhaseKey(static_cast<Task::Phase>(phase));
+      const auto& stats = perf_results->allocations[phase];
+      allocations_str << (phase > 0 ? ";" : "") << key << "_count=" << stats.count << ";" << key
+                      << "_bytes=" << stats.bytes;
+    }
+    std::cout << relative_path << ":" << type_test_name << ":allocations:" << allocations_str.str() << '\n';
+  }
+  if (perf_results->peak_rss_bytes > 0) {
+    std::cout << relative_path << ":" << type_test_name << ":peak_rss:" << perf_results->peak_rss_bytes << '\n';
+  }
+
+  // The statistic of an overrun is printed in any mode, so the measurement is
+  // not lost
+  const bool is_overrun = time_secs >= perf_results->max_time_sec;
+  if (mode == kMachineReadable || is_overrun) {
+    std::stringstream stat_str;
+    stat_str << std::fixed << std::setprecision(10);
+    stat_str << "count=" << perf_results->samples_sec.size() << ";min=" << perf_results->min_sec
+             << ";median=" << perf_results->median_sec << ";p90=" << perf_results->p90_sec
+             << ";p99=" << perf_results->p99_sec << ";max=" << perf_results->max_sec
+             << ";mean=" << perf_results->mean_sec << ";stddev=" << perf_results->stddev_sec
+             << ";median_relative_error=" << perf_results->median_relative_error
+             << ";scratch_high_water_bytes=" << perf_results->scratch_high_water_bytes;
+    std::cout << relative_path << ":" << type_test_name << ":statistic:" << stat_str.str() << '\n';
+
+    if (perf_results->counters.AnyAvailable()) {
+      std::stringstream counters_str;
+      for (uint8_t event = 0; event < PerfCounters::kNumEvents; event++) {
+        if (!perf_results->counters.available[event]) {
+          continue;
+        }
+        const auto* name = PerfCounters::Name(static_cast<PerfCounters::Event>(event));
+        counters_str << (counters_str.tellp() > 0 ? ";" : "") << name << "=" << perf_results->counters.values[event];
+      }
+      std::cout << relative_path << ":" << type_test_name << ":counters:" << counters_str.str() << '\n';
+    }
+  }
+
+  // Structured record does not depend on parsing of the output, which may be
+  // mixed with output of other processes
+  if (const auto sink = GetResultsSink()) {
+    sink->Write(PerfRecord::Make(relative_path, type_test_name, *perf_results));
+  }
+
+  std::stringstream err_msg;
+  if (is_overrun) {
     err_msg << '\n' << "Task execute time need to be: ";
-    err_msg << "time < " << PerfResults::kMaxTime << " secs." << '\n';
+    err_msg << "time < " << perf_results->max_time_sec << " secs." << '\n';
     err_msg << "Original time in secs: " << time_secs << '\n';
-    perf_res_str << std::fixed << std::setprecision(10) << -1.0;
-    std::cout << relative_path << ":" << type_test_name << ":" << perf_res_str.str() << '\n';
+    if (perf_results->soft_time_limit) {
+      std::cerr << "WARNING:" << err_msg.str();
+    }
+  }
+
+  // Time of a failed test is printed as -1
+  const bool is_failed = is_overrun && !perf_results->soft_time_limit;
+  std::stringstream perf_res_str;
+  perf_res_str << std::fixed << std::setprecision(10) << (is_failed ? -1.0 : time_secs);
+  std::cout << relative_path << ":" << type_test_name << ":" << perf_res_str.str() << '\n';
+  if (is_failed) {
     throw std::runtime_error(err_msg.str().c_str());
   }
 }
@@ -0,0 +1,133 @@
+#include "core/perf/include/perf_counters.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+constexpr int kClosedFd = -1;
+
+#ifdef __linux__
+int OpenCounter(uint32_t type, uint64_t config) {
+  perf_event_attr attr{};
+  attr.size = sizeof(attr);
+  attr.type = type;
+  attr.config = config;
+  attr.disabled = 1;
+  attr.inherit = 1;
+  attr.exclude_hv = 1;
+  attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+  // Context switches happen in the kernel, so they are counted there if the
+  // system allows it, hardware events are user space only
+  attr.exclude_kernel = (type == PERF_TYPE_SOFTWARE) ? 0 : 1;
+  auto fd = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, PERF_FLAG_FD_CLOEXEC));
+  if (fd < 0 && type == PERF_TYPE_SOFTWARE) {
+    attr.exclude_kernel = 1;
+    fd = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, PERF_FLAG_FD_CLOEXEC));
+  }
+  return fd < 0 ? kClosedFd : fd;
+}
+
+uint64_t CacheConfig(uint64_t cache, uint64_t op, uint64_t result) { return cache | (op << 8) | (result << 16); }
+#endif
+
+}  // namespace
+
+const char* ppc::core::PerfCounters::Name(Event event) {
+  switch (event) {
+    case kCycles:
+      return "cycles";
+    case kInstructions:
+      return "instructions";
+    case kL1dMisses:
+      return "l1d_misses";
+    case kLlcMisses:
+      return "llc_misses";
+    case kBranchMisses:
+      return "branch_misses";
+    case kContextSwitches:
+      return "context_switches";
+    case kNumEvents:
+      break;
+  }
+  return "unknown";
+}
+
+bool ppc::core::PerfCounters::AnyAvailable() const {
+  return std::ranges::any_of(available, [](bool is_available) { return is_available; });
+}
+
+ppc::core::HardwareCounters::HardwareCounters() {
+  fds_.fill(kClosedFd);
+#ifdef __linux__
+  fds_[PerfCounters::kCycles] = OpenCounter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES);
+  fds_[PerfCounters::kInstructions] = OpenCounter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS);
+  fds_[PerfCounters::kL1dMisses] = OpenCounter(
+      PERF_TYPE_HW_CACHE,
+      CacheConfig(PERF_COUNT_HW_CACHE_L1D, PERF_COUNT_HW_CACHE_OP_READ, PERF_COUNT_HW_CACHE_RESULT_MISS));
+  fds_[PerfCounters::kLlcMisses] = OpenCounter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES);
+  fds_[PerfCounters::kBranchMisses] = OpenCounter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES);
+  fds_[PerfCounters::kContextSwitches] = OpenCounter(PERF_TYPE_SOFTWARE, PERF_COUNT_SW_CONTEXT_SWITCHES);
+#endif
+}
+
+ppc::core::HardwareCounters::~HardwareCounters() {
+#ifdef __linux__
+  for (auto fd : fds_) {
+    if (fd != kClosedFd) {
+      close(fd);
+    }
+  }
+#endif
+}
+
+void ppc::core::HardwareCounters::Start() {
+#ifdef __linux__
+  for (auto fd : fds_) {
+    if (fd != kClosedFd) {
+      ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+      ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+    }
+  }
+#endif
+}
+
+void ppc::core::HardwareCounters::Stop() {
+#ifdef __linux__
+  for (auto fd : fds_) {
+    if (fd != kClosedFd) {
+      ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+    }
+  }
+#endif
+}
+
+ppc::core::PerfCounters ppc::core::HardwareCounters::Read() const {
+  PerfCounters counters;
+#ifdef __linux__
+  for (size_t i = 0; i < fds_.size(); i++) {
+    if (fds_[i] == kClosedFd) {
+      continue;
+    }
+    // value, time enabled, time running
+    std::array<uint64_t, 3> data{};
+    if (read(fds_[i], data.data(), sizeof(data)) != static_cast<ssize_t>(sizeof(data)) || data[2] == 0) {
+      continue;
+    }
+    const auto scale = static_cast<double>(data[1]) / static_cast<double>(data[2]);
+    counters.values[i] = static_cast<uint64_t>(static_cast<double>(data[0]) * scale);
+    counters.available[i] = true;
+  }
+#endif
+  return counters;
+}
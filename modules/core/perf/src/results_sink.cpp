@@ -0,0 +1,216 @@
+#include "core/perf/include/results_sink.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <utility>
+
+#include "core/perf/include/perf.hpp"
+#include "core/util/include/topology.hpp"
+#include "core/util/include/util.hpp"
+
+#ifndef _WIN32
+#include <unistd.h>
+#endif
+
+namespace {
+
+constexpr std::array<const char*, 4> kPhaseKeys = {"validation", "pre_processing", "run", "post_processing"};
+
+std::string HostName() {
+#ifdef _WIN32
+  return ppc::util::GetEnv("COMPUTERNAME");
+#else
+  std::array<char, 256> name{};
+  if (gethostname(name.data(), name.size() - 1) != 0) {
+    return {};
+  }
+  return name.data();
+#endif
+}
+
+// Number of processes of the MPI job, the core does not depend on MPI, so it
+// is taken from variables set by mpirun/mpiexec of Open MPI, MPICH and Intel MPI
+int NumProcesses() {
+  for (const auto* name : {"OMPI_COMM_WORLD_SIZE", "PMI_SIZE", "PMIX_SIZE"}) {
+    const auto value = ppc::util::GetEnv(name);
+    if (!value.empty()) {
+      return std::max(std::atoi(value.c_str()), 1);
+    }
+  }
+  return 1;
+}
+
+// PPC_GIT_REVISION from the environment (e.g. set by CI), otherwise the
+// revision of sources at configure time
+std::string GitRevision() {
+  auto revision = ppc::util::GetEnv("PPC_GIT_REVISION");
+  if (!revision.empty()) {
+    return revision;
+  }
+#ifdef PPC_GIT_REVISION
+  return PPC_GIT_REVISION;
+#else
+  return "unknown";
+#endif
+}
+
+std::string JsonString(const std::string& value) {
+  std::stringstream str;
+  str << '"';
+  for (const char c : value) {
+    switch (c) {
+      case '"':
+        str << "\\\"";
+        break;
+      case '\\':
+        str << "\\\\";
+        break;
+      case '\n':
+        str << "\\n";
+        break;
+      default:
+        if (static_cast<unsigned char>(c) < 0x20) {
+          str << "\\u" << std::hex << std::setw(4) << std::setfill('0') << static_cast<int>(c) << std::dec;
+        } else {
+          str << c;
+        }
+    }
+  }
+  str << '"';
+  return str.str();
+}
+
+std::string CsvString(const std::string& value) {
+  if (value.find_first_of(",\"\n") == std::string::npos) {
+    return value;
+  }
+  std::string quoted = "\"";
+  for (const char c : value) {
+    quoted += c == '"' ? std::string("\"\"") : std::string(1, c);
+  }
+  return quoted + "\"";
+}
+
+template <class Range>
+std::string Joined(const Range& values, const char* separator) {
+  std::stringstream str;
+  str << std::fixed << std::setprecision(10);
+  bool first = true;
+  for (const auto value : values) {
+    str << (first ? "" : separator) << value;
+    first = false;
+  }
+  return str.str();
+}
+
+std::ofstream OpenForAppend(const std::string& path) {
+  std::ofstream file(path, std::ios::app);
+  if (!file) {
+    throw std::runtime_error("Can't open file of perf results: " + path);
+  }
+  return file;
+}
+
+std::mutex sink_mutex;
+std::shared_ptr<ppc::core::ResultsSink> sink;
+bool sink_is_set = false;
+
+}  // namespace
+
+ppc::core::PerfRecord ppc::core::PerfRecord::Make(const std::string& path, const std::string& type_of_running,
+                                                  const PerfResults& perf_results) {
+  PerfRecord record;
+  record.path = path;
+  // tasks/<backend>/<task>
+  const std::filesystem::path task_path(path);
+  record.task = task_path.filename().string();
+  record.backend = task_path.parent_path().filename().string();
+  record.type_of_running = type_of_running;
+  record.problem_size = perf_results.problem_size;
+  record.num_threads = ppc::util::GetPPCNumThreads();
+  record.num_processes = NumProcesses();
+  record.work_scale = ppc::util::GetPPCWorkScale();
+  record.time_sec = perf_results.time_sec;
+  record.median_sec = perf_results.median_sec;
+  record.samples_sec = perf_results.samples_sec;
+  for (size_t phase = 0; phase < record.phase_mean_sec.size(); phase++) {
+    record.phase_mean_sec[phase] = perf_results.phases[phase].MeanSec();
+  }
+  record.pinning = ppc::util::DescribePPCPinning();
+  record.host = HostName();
+  record.host_cpus = static_cast<int>(std::thread::hardware_concurrency());
+  record.git_revision = GitRevision();
+  return record;
+}
+
+void ppc::core::JsonlResultsSink::Write(const PerfRecord& record) {
+  std::stringstream line;
+  line << std::fixed << std::setprecision(10);
+  line << "{\"path\":" << JsonString(record.path) << ",\"task\":" << JsonString(record.task)
+       << ",\"backend\":" << JsonString(record.backend) << ",\"type_of_running\":" << JsonString(record.type_of_running)
+       << ",\"problem_size\":" << record.problem_size
+       << ",\"num_threads\":" << record.num_threads << ",\"num_processes\":" << record.num_processes
+       << ",\"work_scale\":" << record.work_scale << ",\"time_sec\":" << record.time_sec
+       << ",\"median_sec\":" << record.median_sec << ",\"samples_sec\":[" << Joined(record.samples_sec, ",")
+       << "],\"phase_mean_sec\":{";
+  for (size_t phase = 0; phase < kPhaseKeys.size(); phase++) {
+    line << (phase > 0 ? "," : "") << JsonString(kPhaseKeys[phase]) << ":" << record.phase_mean_sec[phase];
+  }
+  line << "},\"pinning\":" << JsonString(record.pinning) << ",\"host\":" << JsonString(record.host)
+       << ",\"host_cpus\":" << record.host_cpus << ",\"git_revision\":" << JsonString(record.git_revision) << "}\n";
+
+  // The record is written by one call, so lines of concurrent writers are not mixed
+  auto file = OpenForAppend(path_);
+  file << line.str() << std::flush;
+}
+
+void ppc::core::CsvResultsSink::Write(const PerfRecord& record) {
+  std::stringstream row;
+  std::error_code error;
+  if (!std::filesystem::exists(path_, error) || std::filesystem::file_size(path_, error) == 0) {
+    row << "path,task,backend,type_of_running,problem_size,num_threads,num_processes,work_scale,time_sec,median_sec,"
+        << "samples_sec,phase_mean_sec,pinning,host,host_cpus,git_revision\n";
+  }
+  row << std::fixed << std::setprecision(10);
+  row << CsvString(record.path) << "," << CsvString(record.task) << "," << CsvString(record.backend) << ","
+      << CsvString(record.type_of_running) << "," << record.problem_size << "," << record.num_threads << ","
+      << record.num_processes << "," << record.work_scale << "," << record.time_sec << "," << record.median_sec << ","
+      << Joined(record.samples_sec, " ") << "," << Joined(record.phase_mean_sec, " ") << ","
+      << CsvString(record.pinning) << "," << CsvString(record.host) << "," << record.host_cpus << ","
+      << CsvString(record.git_revision) << "\n";
+
+  auto file = OpenForAppend(path_);
+  file << row.str() << std::flush;
+}
+
+std::shared_ptr<ppc::core::ResultsSink> ppc::core::GetResultsSink() {
+  const std::lock_guard lock(sink_mutex);
+  if (!sink_is_set) {
+    const auto path = ppc::util::GetEnv("PPC_PERF_RESULTS");
+    if (!path.empty()) {
+      const bool is_csv = std::filesystem::path(path).extension() == ".csv";
+      sink = is_csv ? std::shared_ptr<ResultsSink>(std::make_shared<CsvResultsSink>(path))
+                    : std::shared_ptr<ResultsSink>(std::make_shared<JsonlResultsSink>(path));
+    }
+    sink_is_set = true;
+  }
+  return sink;
+}
+
+void ppc::core::SetResultsSink(std::shared_ptr<ResultsSink> new_sink) {
+  const std::lock_guard lock(sink_mutex);
+  sink = std::move(new_sink);
+  sink_is_set = true;
+}
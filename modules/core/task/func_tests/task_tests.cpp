@@ -1,12 +1,16 @@
 #include <gtest/gtest.h>
 
+#include <algorithm>
 #include <cstddef>
 #include <cstdint>
 #include <memory>
+#include <numeric>
+#include <utility>
 #include <vector>
 
 #include "core/task/func_tests/test_task.hpp"
 #include "core/task/include/task.hpp"
+#include "core/util/include/numa.hpp"
 
 TEST(task_tests, check_int32_t) {
   // Create data
@@ -52,6 +56,35 @@ TEST(task_tests, check_int32_t_slow) {
   ASSERT_EQ(static_cast<size_t>(out[0]), in.size());
 }
 
+TEST(task_tests, check_time_limit_of_task_data) {
+  // Create data
+  std::vector<int32_t> in(20, 1);
+  std::vector<int32_t> out(1, 0);
+
+  // Create TaskData
+  auto task_data = std::make_shared<ppc::core::TaskData>();
+  task_data->inputs.emplace_back(reinterpret_cast<uint8_t *>(in.data()));
+  task_data->inputs_count.emplace_back(in.size());
+  task_data->outputs.emplace_back(reinterpret_cast<uint8_t *>(out.data()));
+  task_data->outputs_count.emplace_back(out.size());
+  task_data->max_test_time = 1e-12;
+
+  // Create Task
+  ppc::test::task::TestTask<int32_t> test_task(task_data);
+  ASSERT_TRUE(test_task.Validation());
+  test_task.PreProcessing();
+  test_task.Run();
+  ASSERT_ANY_THROW(test_task.PostProcessing());
+
+  // The overrun of a soft limit is only reported
+  task_data->soft_time_limit = true;
+  ASSERT_TRUE(test_task.Validation());
+  test_task.PreProcessing();
+  test_task.Run();
+  ASSERT_NO_THROW(test_task.PostProcessing());
+  ASSERT_EQ(static_cast<size_t>(out[0]), in.size());
+}
+
 TEST(task_tests, check_validate_func) {
   // Create data
   std::vector<int32_t> in(20, 1);
@@ -178,7 +211,201 @@ TEST(task_tests, check_wrong_order) {
   ASSERT_ANY_THROW(test_task.PostProcessing());
 }
 
+TEST(task_tests, check_prepare_input_modes) {
+  // Create data
+  std::vector<int32_t> in(20, 1);
+
+  // Create task_data
+  auto task_data = std::make_shared<ppc::core::TaskData>();
+  task_data->inputs.emplace_back(reinterpret_cast<uint8_t *>(in.data()));
+  task_data->inputs_count.emplace_back(in.size());
+
+  std::vector<int32_t> storage;
+  auto view = ppc::core::PrepareInput(*task_data, 0, ppc::core::InputMode::kView, storage);
+  EXPECT_EQ(view.data(), in.data());
+  EXPECT_EQ(view.size(), in.size());
+  EXPECT_TRUE(storage.empty());
+
+  auto copy = ppc::core::PrepareInput(*task_data, 0, ppc::core::InputMode::kCopy, storage);
+  EXPECT_EQ(copy.data(), storage.data());
+  EXPECT_EQ(storage, in);
+}
+
+TEST(task_tests, check_prepare_input_first_touch) {
+  // Create data
+  std::vector<int32_t> in(1000);
+  std::iota(in.begin(), in.end(), 0);
+
+  // Create task_data
+  auto task_data = std::make_shared<ppc::core::TaskData>();
+  task_data->inputs.emplace_back(reinterpret_cast<uint8_t *>(in.data()));
+  task_data->inputs_count.emplace_back(in.size());
+
+  // Chunks of 128 elements copied in reverse order, like threads finishing in any order
+  std::vector<std::pair<size_t, size_t>> chunks;
+  auto loop = [&](size_t size, const auto &body) {
+    for (size_t begin = ((size - 1) / 128) * 128;; begin -= 128) {
+      chunks.emplace_back(begin, std::min(begin + 128, size));
+      body(begin, std::min(begin + 128, size));
+      if (begin == 0) {
+        break;
+      }
+    }
+  };
+
+  ppc::util::FirstTouchVector<int32_t> storage;
+  auto copy = ppc::core::PrepareInput(*task_data, 0, ppc::core::InputMode::kCopy, storage, loop);
+  EXPECT_EQ(copy.data(), storage.data());
+  EXPECT_TRUE(std::equal(in.begin(), in.end(), storage.begin(), storage.end()));
+  EXPECT_EQ(chunks.size(), 8U);
+
+  // The copy is refreshed in place when the size doesn't change
+  const auto *data = storage.data();
+  in[0] = -1;
+  ppc::core::PrepareInput(*task_data, 0, ppc::core::InputMode::kCopy, storage, loop);
+  EXPECT_EQ(storage.data(), data);
+  EXPECT_EQ(storage[0], -1);
+}
+
+TEST(task_tests, check_wrong_first_function) {
+  // Create data
+  std::vector<float> in(20, 1);
+  std::vector<float> out(1, 0);
+
+  // Create task_data
+  auto task_data = std::make_shared<ppc::core::TaskData>();
+  task_data->inputs.emplace_back(reinterpret_cast<uint8_t *>(in.data()));
+  task_data->inputs_count.emplace_back(in.size());
+  task_data->outputs.emplace_back(reinterpret_cast<uint8_t *>(out.data()));
+  task_data->outputs_count.emplace_back(out.size());
+
+  // Create Task
+  ppc::test::task::TestTask<float> test_task(task_data);
+  ASSERT_ANY_THROW(test_task.Run());
+}
+
+TEST(task_tests, check_repeated_cycles) {
+  // Create data
+  std::vector<int32_t> in(20, 1);
+  std::vector<int32_t> out(1, 0);
+
+  // Create task_data
+  auto task_data = std::make_shared<ppc::core::TaskData>();
+  task_data->inputs.emplace_back(reinterpret_cast<uint8_t *>(in.data()));
+  task_data->inputs_count.emplace_back(in.size());
+  task_data->outputs.emplace_back(reinterpret_cast<uint8_t *>(out.data()));
+  task_data->outputs_count.emplace_back(out.size());
+
+  // Create Task, order checking has to stay cheap for long perf runs
+  ppc::test::task::TestTask<int32_t> test_task(task_data);
+  task_data->state_of_testing = ppc::core::TaskData::StateOfTesting::kPerf;
+  for (int i = 0; i < 100000; i++) {
+    ASSERT_EQ(test_task.Validation(), true);
+    test_task.PreProcessing();
+    test_task.Run();
+    test_task.Run();
+    test_task.PostProcessing();
+  }
+  ASSERT_EQ(static_cast<size_t>(out[0]), 2 * in.size());
+  ASSERT_ANY_THROW(test_task.Run());
+}
+
+TEST(task_tests, check_buffers) {
+  // Create data
+  std::vector<int32_t> in(20, 1);
+  auto out = ppc::core::Buffer::Allocate<int32_t>(1);
+  EXPECT_TRUE(out.IsOwning());
+  EXPECT_TRUE(out.IsAligned(ppc::core::kBufferAlignment));
+  EXPECT_EQ(out.type, ppc::core::ElementType::kInt32);
+
+  // Create task_data
+  auto task_data = std::make_shared<ppc::core::TaskData>();
+  task_data->input_buffers.emplace_back(ppc::core::Buffer::Borrow(in.data(), in.size()));
+  task_data->output_buffers.emplace_back(out);
+  EXPECT_FALSE(task_data->input_buffers[0].IsOwning());
+  EXPECT_EQ(task_data->Input<int32_t>(0).data(), in.data());
+  EXPECT_EQ(task_data->NumInputs(), 1U);
+  EXPECT_ANY_THROW(static_cast<void>(task_data->Input<float>(0)));
+
+  // Create Task
+  ppc::test::task::TestTask<int32_t> test_task(task_data);
+  bool is_valid = test_task.Validation();
+  ASSERT_EQ(is_valid, true);
+  test_task.PreProcessing();
+  test_task.Run();
+  test_task.PostProcessing();
+  ASSERT_EQ(static_cast<size_t>(out.As<int32_t>()[0]), in.size());
+}
+
+TEST(task_tests, check_owning_buffer_deleter) {
+  int num_deleted = 0;
+  {
+    auto buffer = ppc::core::Buffer::Own<double>(new double[4]{}, 4, [&num_deleted](const double *data) {
+      num_deleted++;
+      delete[] data;
+    });
+    auto copy = buffer;
+    EXPECT_EQ(copy.SizeInBytes(), 4 * sizeof(double));
+  }
+  EXPECT_EQ(num_deleted, 1);
+}
+
 int main(int argc, char **argv) {
   testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();
 }
+
+TEST(task_tests, check_scratch_arena) {
+  ppc::core::ScratchArena arena;
+  auto first = arena.Allocate<uint8_t>(3);
+  auto second = arena.Allocate<double>(1000);
+  EXPECT_EQ(reinterpret_cast<uintptr_t>(first.data()) % ppc::core::ScratchArena::kAlignment, 0U);
+  EXPECT_EQ(reinterpret_cast<uintptr_t>(second.data()) % ppc::core::ScratchArena::kAlignment, 0U);
+  EXPECT_EQ(second.size(), 1000U);
+  EXPECT_EQ(arena.Used(), ppc::core::ScratchArena::kAlignment + (1000 * sizeof(double)));
+
+  // Buffers beyond the first block take new blocks, after a reset they are
+  // merged, so the same buffers don't need the heap anymore
+  static_cast<void>(arena.Allocate<double>(100000));
+  const auto high_water_mark = arena.HighWaterMark();
+  EXPECT_GE(high_water_mark, 101000 * sizeof(double));
+  EXPECT_EQ(arena.NumHeapAllocations(), 2U);
+
+  arena.Reset();
+  EXPECT_EQ(arena.Used(), 0U);
+  EXPECT_GE(arena.Capacity(), high_water_mark);
+  const auto num_heap_allocations = arena.NumHeapAllocations();
+  static_cast<void>(arena.Allocate<uint8_t>(3));
+  static_cast<void>(arena.Allocate<double>(1000));
+  static_cast<void>(arena.Allocate<double>(100000));
+  EXPECT_EQ(arena.NumHeapAllocations(), num_heap_allocations);
+  EXPECT_EQ(arena.HighWaterMark(), high_water_mark);
+}
+
+TEST(task_tests, check_scratch_is_reused_between_runs) {
+  // Create data
+  std::vector<int32_t> in(50000, 1);
+  std::vector<int32_t> out(1, 0);
+
+  // Create task_data
+  auto task_data = std::make_shared<ppc::core::TaskData>();
+  task_data->inputs.emplace_back(reinterpret_cast<uint8_t *>(in.data()));
+  task_data->inputs_count.emplace_back(in.size());
+  task_data->outputs.emplace_back(reinterpret_cast<uint8_t *>(out.data()));
+  task_data->outputs_count.emplace_back(out.size());
+
+  // Create Task
+  ppc::test::task::ScratchTask<int32_t> test_task(task_data);
+  ASSERT_EQ(test_task.Validation(), true);
+  test_task.PreProcessing();
+  test_task.Run();
+  const auto num_heap_allocations = test_task.GetScratch().NumHeapAllocations();
+  for (int i = 0; i < 10; i++) {
+    test_task.Run();
+  }
+  test_task.PostProcessing();
+
+  EXPECT_EQ(out[0], 11 * static_cast<int32_t>(in.size()));
+  EXPECT_EQ(test_task.GetScratch().NumHeapAllocations(), num_heap_allocations);
+  EXPECT_EQ(test_task.GetScratch().HighWaterMark(), in.size() * sizeof(int32_t));
+}
@@ -1,6 +1,8 @@
 #pragma once
 
+#include <algorithm>
 #include <chrono>
+#include <span>
 #include <thread>
 #include <vector>
 
@@ -13,17 +15,17 @@ class TestTask : public ppc::core::Task {
  public:
   explicit TestTask(const ppc::core::TaskDataPtr &task_data) : Task(task_data) {}
   bool PreProcessingImpl() override {
-    input_ = reinterpret_cast<T *>(task_data->inputs[0]);
-    output_ = reinterpret_cast<T *>(task_data->outputs[0]);
+    input_ = task_data->Input<T>(0);
+    output_ = task_data->Output<T>(0).data();
     output_[0] = 0;
     return true;
   }
 
-  bool ValidationImpl() override { return task_data->outputs_count[0] == 1; }
+  bool ValidationImpl() override { return task_data->Output<T>(0).size() == 1; }
 
   bool RunImpl() override {
-    for (unsigned i = 0; i < task_data->inputs_count[0]; i++) {
-      output_[0] += input_[i];
+    for (const auto &value : input_) {
+      output_[0] += value;
     }
     return true;
   }
@@ -31,7 +33,7 @@ class TestTask : public ppc::core::Task {
   bool PostProcessingImpl() override { return true; }
 
  private:
-  T *input_{};
+  std::span<const T> input_;
   T *output_{};
 };
 
@@ -46,4 +48,22 @@ class FakeSlowTask : public TestTask<T> {
   }
 };
 
+// Sums a copy of the input kept in scratch memory of the task
+template <class T>
+class ScratchTask : public TestTask<T> {
+ public:
+  explicit ScratchTask(const ppc::core::TaskDataPtr &task_data) : TestTask<T>(task_data) {}
+
+  bool RunImpl() override {
+    const auto input = this->task_data->template Input<T>(0);
+    auto copy = this->Scratch().template Allocate<T>(input.size());
+    std::ranges::copy(input, copy.begin());
+    auto *output = this->task_data->template Output<T>(0).data();
+    for (const auto &value : copy) {
+      output[0] += value;
+    }
+    return true;
+  }
+};
+
 }  // namespace ppc::test::task
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+namespace ppc::core {
+
+// Bump allocator of temporary buffers of one Run(). Buffers are 64-byte
+// aligned and live until Reset(), which releases all of them at once. After a
+// reset the memory is merged into one block big enough for the largest run
+// seen so far, so repeated runs with the same sizes don't touch the heap.
+class ScratchArena {
+ public:
+  static constexpr size_t kAlignment = 64;
+
+  ScratchArena() = default;
+  ScratchArena(const ScratchArena &) = delete;
+  ScratchArena &operator=(const ScratchArena &) = delete;
+  ScratchArena(ScratchArena &&) = default;
+  ScratchArena &operator=(ScratchArena &&) = default;
+  ~ScratchArena() = default;
+
+  // Uninitialized buffer of count elements
+  template <class T>
+  std::span<T> Allocate(size_t count) {
+    static_assert(std::is_trivially_copyable_v<T> && std::is_trivially_destructible_v<T>);
+    static_assert(alignof(T) <= kAlignment);
+    return {static_cast<T *>(AllocateBytes(count * sizeof(T))), count};
+  }
+  void *AllocateBytes(size_t size);
+
+  // Releases all buffers, they must not be used afterwards
+  void Reset();
+
+  // Bytes handed out since the last reset, including alignment padding
+  [[nodiscard]] size_t Used() const { return used_; }
+  // The largest Used() ever observed
+  [[nodiscard]] size_t HighWaterMark() const { return high_water_mark_; }
+  [[nodiscard]] size_t Capacity() const;
+  // Number of blocks taken from the heap so far
+  [[nodiscard]] uint64_t NumHeapAllocations() const { return num_heap_allocations_; }
+
+ private:
+  struct BlockDeleter {
+    void operator()(std::byte *ptr) const { ::operator delete[](ptr, std::align_val_t{kAlignment}); }
+  };
+  struct Block {
+    std::unique_ptr<std::byte[], BlockDeleter> data;
+    size_t size = 0;
+  };
+
+  void AddBlock(size_t min_size);
+
+  std::vector<Block> blocks_;
+  size_t current_block_ = 0;
+  size_t offset_ = 0;
+  size_t used_ = 0;
+  size_t high_water_mark_ = 0;
+  uint64_t num_heap_allocations_ = 0;
+};
+
+}  // namespace ppc::core
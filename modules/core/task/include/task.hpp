@@ -1,27 +1,218 @@
 #pragma once
 
+#include <algorithm>
+#include <bit>
 #include <chrono>
+#include <cstddef>
 #include <cstdint>
+#include <functional>
 #include <memory>
-#include <string>
+#include <new>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
 #include <vector>
 
+#include "core/task/include/scratch_arena.hpp"
+
 namespace ppc::core {
 
+// Alignment of buffers allocated by Buffer::Allocate, enough for aligned
+// loads of the widest vector registers
+constexpr size_t kBufferAlignment = 64;
+
+// Type of elements stored in a buffer
+enum class ElementType : uint8_t {
+  kUnknown,
+  kInt8,
+  kUInt8,
+  kInt16,
+  kUInt16,
+  kInt32,
+  kUInt32,
+  kInt64,
+  kUInt64,
+  kFloat,
+  kDouble
+};
+
+template <class T>
+constexpr ElementType ElementTypeOf() {
+  using U = std::remove_cv_t<T>;
+  if constexpr (std::is_same_v<U, float>) {
+    return ElementType::kFloat;
+  } else if constexpr (std::is_same_v<U, double>) {
+    return ElementType::kDouble;
+  } else if constexpr (std::is_integral_v<U> && !std::is_same_v<U, bool>) {
+    constexpr bool kSigned = std::is_signed_v<U>;
+    switch (sizeof(U)) {
+      case 1:
+        return kSigned ? ElementType::kInt8 : ElementType::kUInt8;
+      case 2:
+        return kSigned ? ElementType::kInt16 : ElementType::kUInt16;
+      case 4:
+        return kSigned ? ElementType::kInt32 : ElementType::kUInt32;
+      case 8:
+        return kSigned ? ElementType::kInt64 : ElementType::kUInt64;
+      default:
+        return ElementType::kUnknown;
+    }
+  } else {
+    return ElementType::kUnknown;
+  }
+}
+
+// Typed description of an input or output buffer. The buffer either borrows
+// memory of the caller or owns it, then memory is released by the deleter
+// when the last copy of the descriptor is destroyed
+struct Buffer {
+  uint8_t *data = nullptr;
+  uint64_t count = 0;
+  size_t element_size = 0;
+  size_t alignment = 1;
+  ElementType type = ElementType::kUnknown;
+  std::shared_ptr<void> owner;
+
+  [[nodiscard]] bool IsOwning() const { return owner != nullptr; }
+  [[nodiscard]] bool IsAligned(size_t required) const { return alignment >= required; }
+  [[nodiscard]] uint64_t SizeInBytes() const { return count * element_size; }
+
+  // Buffer over memory owned by the caller
+  template <class T>
+  static Buffer Borrow(T *data, uint64_t count) {
+    const auto address = reinterpret_cast<uintptr_t>(data);
+    const auto alignment =
+        address == 0 ? kBufferAlignment : std::min(size_t{1} << std::countr_zero(address), kBufferAlignment);
+    return {.data = reinterpret_cast<uint8_t *>(const_cast<std::remove_cv_t<T> *>(data)),
+            .count = count,
+            .element_size = sizeof(T),
+            .alignment = alignment,
+            .type = ElementTypeOf<T>(),
+            .owner = nullptr};
+  }
+
+  // Buffer which takes ownership of memory and releases it with the deleter
+  template <class T>
+  static Buffer Own(T *data, uint64_t count, std::function<void(T *)> deleter = std::default_delete<T[]>()) {
+    auto buffer = Borrow(data, count);
+    buffer.owner = std::shared_ptr<void>(data, [deleter = std::move(deleter)](void *ptr) {
+      deleter(static_cast<T *>(ptr));
+    });
+    return buffer;
+  }
+
+  // Owning buffer of count value-initialized elements with given alignment
+  template <class T>
+  static Buffer Allocate(uint64_t count, size_t alignment = kBufferAlignment) {
+    static_assert(std::is_trivially_copyable_v<T> && std::is_trivially_destructible_v<T>);
+    alignment = std::max(alignment, alignof(T));
+    auto *data = static_cast<T *>(::operator new(count * sizeof(T), std::align_val_t{alignment}));
+    std::uninitialized_value_construct_n(data, count);
+    auto buffer = Borrow(data, count);
+    buffer.alignment = std::max(buffer.alignment, alignment);
+    buffer.owner = std::shared_ptr<void>(data, [alignment](void *ptr) {
+      ::operator delete(ptr, std::align_val_t{alignment});
+    });
+    return buffer;
+  }
+
+  // Typed view of the elements, throws if T does not match the element type
+  template <class T>
+  std::span<T> As() const {
+    if (element_size != sizeof(T) ||
+        (type != ElementType::kUnknown && ElementTypeOf<T>() != ElementType::kUnknown && type != ElementTypeOf<T>())) {
+      throw std::invalid_argument("Type of buffer elements does not match the requested one");
+    }
+    return {reinterpret_cast<T *>(data), static_cast<size_t>(count)};
+  }
+};
+
 struct TaskData {
   std::vector<uint8_t *> inputs;
   std::vector<std::uint32_t> inputs_count;
   std::vector<uint8_t *> outputs;
   std::vector<std::uint32_t> outputs_count;
   enum StateOfTesting : uint8_t { kFunc, kPerf } state_of_testing;
+  // limit of PreProcessing() -> PostProcessing() in func tests (in seconds), 0
+  // takes PPC_FUNC_MAX_TIME or 1 second. An overrun of a soft limit is only
+  // reported, PPC_SOFT_TIME_LIMITS=1 makes all limits soft
+  double max_test_time = 0.0;
+  bool soft_time_limit = false;
+
+  // Typed buffers, when they are set they are used instead of the legacy
+  // inputs/outputs fields by Input() and Output()
+  std::vector<Buffer> input_buffers;
+  std::vector<Buffer> output_buffers;
+
+  template <class T>
+  [[nodiscard]] std::span<const T> Input(size_t index) const {
+    if (!input_buffers.empty()) {
+      return input_buffers.at(index).As<const T>();
+    }
+    return {reinterpret_cast<const T *>(inputs.at(index)), inputs_count.at(index)};
+  }
+
+  template <class T>
+  [[nodiscard]] std::span<T> Output(size_t index) const {
+    if (!output_buffers.empty()) {
+      return output_buffers.at(index).As<T>();
+    }
+    return {reinterpret_cast<T *>(outputs.at(index)), outputs_count.at(index)};
+  }
+
+  [[nodiscard]] size_t NumInputs() const { return input_buffers.empty() ? inputs.size() : input_buffers.size(); }
+  [[nodiscard]] size_t NumOutputs() const { return output_buffers.empty() ? outputs.size() : output_buffers.size(); }
 };
 
 using TaskDataPtr = std::shared_ptr<ppc::core::TaskData>;
 
+// Access of task to TaskData::inputs: kCopy keeps a private copy of them,
+// kView reads them in place, so input buffers have to outlive the task
+enum class InputMode : uint8_t { kCopy, kView };
+
+// View of the input with given index, in kCopy mode elements are copied to
+// storage first
+template <class T, class Allocator>
+std::span<const T> PrepareInput(const TaskData &task_data, size_t index, InputMode mode,
+                                std::vector<T, Allocator> &storage) {
+  const auto input = task_data.Input<T>(index);
+  if (mode == InputMode::kView) {
+    storage.clear();
+    return input;
+  }
+  storage.assign(input.begin(), input.end());
+  return storage;
+}
+
+// Same as above, but the copy is made chunk by chunk with loop(size, body),
+// where body(begin, end) copies a chunk. With ppc::util::FirstTouchVector as
+// storage pages of the copy are placed on NUMA nodes of threads of the loop.
+template <class T, class Allocator, class Loop>
+std::span<const T> PrepareInput(const TaskData &task_data, size_t index, InputMode mode,
+                                std::vector<T, Allocator> &storage, const Loop &loop) {
+  const auto input = task_data.Input<T>(index);
+  if (mode == InputMode::kView) {
+    storage.clear();
+    return input;
+  }
+  if (storage.size() != input.size()) {
+    // New memory is not touched before the loop, resizing would copy old elements
+    storage = std::vector<T, Allocator>(input.size(), storage.get_allocator());
+  }
+  loop(input.size(), [&](size_t begin, size_t end) {
+    std::copy(input.begin() + begin, input.begin() + end, storage.begin() + begin);
+  });
+  return storage;
+}
+
 // Memory of inputs and outputs need to be initialized before create object of
 // Task class
 class Task {
  public:
+  // Stages of the task, every cycle has to go through them in this order, Run
+  // may be repeated
+  enum class Phase : uint8_t { kValidation, kPreProcessing, kRun, kPostProcessing };
+
   explicit Task(TaskDataPtr task_data);
 
   // set input and output data
@@ -42,12 +233,19 @@ class Task {
   // get input and output data
   [[nodiscard]] TaskDataPtr GetData() const;
 
+  // scratch memory of runs, e.g. for its high-water mark
+  [[nodiscard]] const ScratchArena &GetScratch() const { return scratch_; }
+
   virtual ~Task();
 
  protected:
-  void InternalOrderTest(const std::string &str = __builtin_FUNCTION());
+  void InternalOrderTest(Phase phase);
   TaskDataPtr task_data;
 
+  // 64-byte aligned temporary buffers of RunImpl(), they are released before
+  // every Run(), so they must not be kept between runs
+  ScratchArena &Scratch() { return scratch_; }
+
   // implementation of "validation" function
   virtual bool ValidationImpl() = 0;
 
@@ -61,10 +259,11 @@ class Task {
   virtual bool PostProcessingImpl() = 0;
 
  private:
-  std::vector<std::string> functions_order_;
-  std::vector<std::string> right_functions_order_ = {"Validation", "PreProcessing", "Run", "PostProcessing"};
-  const double max_test_time_ = 1.0;
-  std::chrono::high_resolution_clock::time_point tmp_time_point_;
+  Phase last_phase_ = Phase::kPostProcessing;
+  uint64_t num_phases_ = 0;
+  constexpr static double kDefaultMaxTestTime = 1.0;
+  std::chrono::steady_clock::time_point tmp_time_point_;
+  ScratchArena scratch_;
 };
 
 }  // namespace ppc::core
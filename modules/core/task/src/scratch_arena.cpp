@@ -0,0 +1,65 @@
+#include "core/task/include/scratch_arena.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <new>
+
+namespace {
+
+// The first block is big enough for small buffers of most kernels, next blocks
+// grow geometrically, so a run makes only a few heap allocations
+constexpr size_t kMinBlockSize = size_t{64} * 1024;
+
+size_t AlignUp(size_t value) {
+  return (value + ppc::core::ScratchArena::kAlignment - 1) / ppc::core::ScratchArena::kAlignment *
+         ppc::core::ScratchArena::kAlignment;
+}
+
+}  // namespace
+
+void *ppc::core::ScratchArena::AllocateBytes(size_t size) {
+  size = AlignUp(std::max<size_t>(size, 1));
+  while (current_block_ < blocks_.size() && offset_ + size > blocks_[current_block_].size) {
+    // The rest of the block is wasted, it is counted to not underestimate the mark
+    used_ += blocks_[current_block_].size - offset_;
+    current_block_++;
+    offset_ = 0;
+  }
+  if (current_block_ == blocks_.size()) {
+    AddBlock(size);
+  }
+
+  auto *ptr = blocks_[current_block_].data.get() + offset_;
+  offset_ += size;
+  used_ += size;
+  high_water_mark_ = std::max(high_water_mark_, used_);
+  return ptr;
+}
+
+void ppc::core::ScratchArena::Reset() {
+  if (blocks_.size() > 1) {
+    // Several blocks mean the runs outgrew the first one, one block of the
+    // total size serves the next runs without allocations
+    const auto total_size = Capacity();
+    blocks_.clear();
+    AddBlock(total_size);
+  }
+  current_block_ = 0;
+  offset_ = 0;
+  used_ = 0;
+}
+
+size_t ppc::core::ScratchArena::Capacity() const {
+  size_t capacity = 0;
+  for (const auto &block : blocks_) {
+    capacity += block.size;
+  }
+  return capacity;
+}
+
+void ppc::core::ScratchArena::AddBlock(size_t min_size) {
+  const auto size = AlignUp(std::max({min_size, kMinBlockSize, blocks_.empty() ? 0 : 2 * blocks_.back().size}));
+  auto *data = static_cast<std::byte *>(::operator new[](size, std::align_val_t{kAlignment}));
+  blocks_.push_back({.data = std::unique_ptr<std::byte[], BlockDeleter>(data), .size = size});
+  num_heap_allocations_++;
+}
@@ -1,15 +1,49 @@
 #include "core/task/include/task.hpp"
 
-#include <cstddef>
 #include <iomanip>
 #include <iostream>
 #include <sstream>
 #include <stdexcept>
 #include <string>
 
+#include "core/util/include/util.hpp"
+
+namespace {
+
+const char* PhaseName(ppc::core::Task::Phase phase) {
+  switch (phase) {
+    case ppc::core::Task::Phase::kValidation:
+      return "Validation";
+    case ppc::core::Task::Phase::kPreProcessing:
+      return "PreProcessing";
+    case ppc::core::Task::Phase::kRun:
+      return "Run";
+    case ppc::core::Task::Phase::kPostProcessing:
+      return "PostProcessing";
+  }
+  return "Unknown";
+}
+
+ppc::core::Task::Phase NextPhase(ppc::core::Task::Phase phase) {
+  switch (phase) {
+    case ppc::core::Task::Phase::kValidation:
+      return ppc::core::Task::Phase::kPreProcessing;
+    case ppc::core::Task::Phase::kPreProcessing:
+      return ppc::core::Task::Phase::kRun;
+    case ppc::core::Task::Phase::kRun:
+      return ppc::core::Task::Phase::kPostProcessing;
+    case ppc::core::Task::Phase::kPostProcessing:
+      return ppc::core::Task::Phase::kValidation;
+  }
+  return ppc::core::Task::Phase::kValidation;
+}
+
+}  // namespace
+
 void ppc::core::Task::SetData(TaskDataPtr task_data_ptr) {
   task_data_ptr->state_of_testing = TaskData::StateOfTesting::kFunc;
-  functions_order_.clear();
+  last_phase_ = Phase::kPostProcessing;
+  num_phases_ = 0;
   this->task_data = std::move(task_data_ptr);
 }
 
@@ -18,58 +52,65 @@ ppc::core::TaskDataPtr ppc::core::Task::GetData() const { return task_data; }
 ppc::core::Task::Task(TaskDataPtr task_data) { SetData(std::move(task_data)); }
 
 bool ppc::core::Task::Validation() {
-  InternalOrderTest();
+  InternalOrderTest(Phase::kValidation);
   return ValidationImpl();
 }
 
 bool ppc::core::Task::PreProcessing() {
-  InternalOrderTest();
+  InternalOrderTest(Phase::kPreProcessing);
   return PreProcessingImpl();
 }
 
 bool ppc::core::Task::Run() {
-  InternalOrderTest();
+  InternalOrderTest(Phase::kRun);
+  scratch_.Reset();
   return RunImpl();
 }
 
 bool ppc::core::Task::PostProcessing() {
-  InternalOrderTest();
+  InternalOrderTest(Phase::kPostProcessing);
   return PostProcessingImpl();
 }
 
-void ppc::core::Task::InternalOrderTest(const std::string& str) {
-  if (!functions_order_.empty() && str == functions_order_.back() && str == "Run") {
+void ppc::core::Task::InternalOrderTest(Phase phase) {
+  if (phase == Phase::kRun && last_phase_ == Phase::kRun) {
     return;
   }
 
-  functions_order_.push_back(str);
-
-  for (size_t i = 0; i < functions_order_.size(); i++) {
-    if (functions_order_[i] != right_functions_order_[i % right_functions_order_.size()]) {
-      throw std::invalid_argument("ORDER OF FUCTIONS IS NOT RIGHT: \n" + std::string("Serial number: ") +
-                                  std::to_string(i + 1) + "\n" + std::string("Yours function: ") + functions_order_[i] +
-                                  "\n" + std::string("Expected function: ") + right_functions_order_[i]);
-    }
+  const auto expected_phase = NextPhase(last_phase_);
+  if (phase != expected_phase) {
+    throw std::invalid_argument("ORDER OF FUCTIONS IS NOT RIGHT: \n" + std::string("Serial number: ") +
+                                std::to_string(num_phases_ + 1) + "\n" + std::string("Yours function: ") +
+                                PhaseName(phase) + "\n" + std::string("Expected function: ") +
+                                PhaseName(expected_phase));
   }
+  last_phase_ = phase;
+  num_phases_++;
 
-  if (str == "PreProcessing" && task_data->state_of_testing == TaskData::StateOfTesting::kFunc) {
-    tmp_time_point_ = std::chrono::high_resolution_clock::now();
+  if (phase == Phase::kPreProcessing && task_data->state_of_testing == TaskData::StateOfTesting::kFunc) {
+    tmp_time_point_ = std::chrono::steady_clock::now();
   }
 
-  if (str == "PostProcessing" && task_data->state_of_testing == TaskData::StateOfTesting::kFunc) {
-    auto end = std::chrono::high_resolution_clock::now();
+  if (phase == Phase::kPostProcessing && task_data->state_of_testing == TaskData::StateOfTesting::kFunc) {
+    auto end = std::chrono::steady_clock::now();
     auto duration = std::chrono::duration_cast<std::chrono::nanoseconds>(end - tmp_time_point_).count();
     auto current_time = static_cast<double>(duration) * 1e-9;
-    if (current_time < max_test_time_) {
+    const auto max_test_time = task_data->max_test_time > 0.0
+                                   ? task_data->max_test_time
+                                   : ppc::util::GetPPCTimeLimit("PPC_FUNC_MAX_TIME", kDefaultMaxTestTime);
+    if (current_time < max_test_time) {
       std::cout << "Test time:" << std::fixed << std::setprecision(10) << current_time;
     } else {
       std::stringstream err_msg;
       err_msg << "\nTask execute time need to be: ";
-      err_msg << "time < " << max_test_time_ << " secs.\n";
+      err_msg << "time < " << max_test_time << " secs.\n";
       err_msg << "Original time in secs: " << current_time << '\n';
-      throw std::runtime_error(err_msg.str().c_str());
+      if (!task_data->soft_time_limit && !ppc::util::GetPPCSoftTimeLimits()) {
+        throw std::runtime_error(err_msg.str().c_str());
+      }
+      std::cerr << "WARNING:" << err_msg.str();
     }
   }
 }
 
-ppc::core::Task::~Task() { functions_order_.clear(); }
+ppc::core::Task::~Task() = default;
@@ -0,0 +1,147 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+#include "core/perf/include/allocation_tracker.hpp"
+#include "core/thread_pool/include/thread_pool.hpp"
+
+TEST(thread_pool_tests, check_submit) {
+  ppc::core::ThreadPool pool(4);
+  std::vector<std::future<int>> results;
+  for (int i = 0; i < 100; i++) {
+    results.emplace_back(pool.Submit([i] { return i * i; }));
+  }
+  for (int i = 0; i < 100; i++) {
+    EXPECT_EQ(results[i].get(), i * i);
+  }
+}
+
+TEST(thread_pool_tests, check_submit_without_workers) {
+  ppc::core::ThreadPool pool(1);
+  EXPECT_EQ(pool.Size(), 1);
+  EXPECT_EQ(pool.Submit([] { return 42; }).get(), 42);
+}
+
+TEST(thread_pool_tests, check_parallel_for_covers_range) {
+  ppc::core::ThreadPool pool(4);
+  for (size_t size : {0, 1, 7, 1000, 12345}) {
+    std::vector<std::atomic<int>> visits(size);
+    pool.ParallelFor(0, size, [&](size_t begin, size_t end) {
+      for (size_t i = begin; i < end; i++) {
+        visits[i]++;
+      }
+    });
+    for (size_t i = 0; i < size; i++) {
+      EXPECT_EQ(visits[i], 1);
+    }
+  }
+}
+
+TEST(thread_pool_tests, check_parallel_for_grain) {
+  ppc::core::ThreadPool pool(4);
+  std::atomic<size_t> min_chunk = 1000;
+  pool.ParallelFor(
+      0, 1000,
+      [&](size_t begin, size_t end) {
+        size_t current = min_chunk;
+        while (end - begin < current && !min_chunk.compare_exchange_weak(current, end - begin)) {
+        }
+      },
+      100);
+  EXPECT_GE(min_chunk, 100);
+}
+
+TEST(thread_pool_tests, check_parallel_reduce) {
+  ppc::core::ThreadPool pool(4);
+  std::vector<int64_t> values(100000);
+  std::iota(values.begin(), values.end(), 1);
+
+  const auto sum = pool.ParallelReduce(
+      0, values.size(), int64_t{0},
+      [&](size_t begin, size_t end) {
+        return std::accumulate(values.begin() + static_cast<std::ptrdiff_t>(begin),
+                               values.begin() + static_cast<std::ptrdiff_t>(end), int64_t{0});
+      },
+      [](int64_t lhs, int64_t rhs) { return lhs + rhs; });
+  EXPECT_EQ(sum, int64_t{100000} * 100001 / 2);
+}
+
+TEST(thread_pool_tests, check_parallel_reduce_keeps_order) {
+  ppc::core::ThreadPool pool(4);
+  const auto digits = pool.ParallelReduce(
+      0, 10, std::vector<size_t>{},
+      [](size_t begin, size_t end) {
+        std::vector<size_t> result(end - begin);
+        std::iota(result.begin(), result.end(), begin);
+        return result;
+      },
+      [](std::vector<size_t> lhs, const std::vector<size_t> &rhs) {
+        lhs.insert(lhs.end(), rhs.begin(), rhs.end());
+        return lhs;
+      });
+  std::vector<size_t> expected(10);
+  std::iota(expected.begin(), expected.end(), 0);
+  EXPECT_EQ(digits, expected);
+}
+
+TEST(thread_pool_tests, check_nested_parallel_for) {
+  ppc::core::ThreadPool pool(2);
+  std::atomic<int> count = 0;
+  pool.ParallelFor(0, 16, [&](size_t begin, size_t end) {
+    for (size_t i = begin; i < end; i++) {
+      pool.ParallelFor(0, 16, [&](size_t inner_begin, size_t inner_end) {
+        count += static_cast<int>(inner_end - inner_begin);
+      });
+    }
+  });
+  EXPECT_EQ(count, 16 * 16);
+}
+
+TEST(thread_pool_tests, check_exception_is_rethrown) {
+  ppc::core::ThreadPool pool(4);
+  EXPECT_THROW(pool.ParallelFor(0, 100,
+                                [](size_t begin, size_t) {
+                                  if (begin == 0) {
+                                    throw std::runtime_error("chunk failed");
+                                  }
+                                }),
+               std::runtime_error);
+
+  std::atomic<int> count = 0;
+  pool.ParallelFor(0, 100, [&](size_t begin, size_t end) { count += static_cast<int>(end - begin); });
+  EXPECT_EQ(count, 100);
+}
+
+TEST(thread_pool_tests, check_global_pool_is_shared) {
+  auto &pool = ppc::core::ThreadPool::Global();
+  EXPECT_EQ(&pool, &ppc::core::ThreadPool::Global());
+  EXPECT_GE(pool.Size(), 1);
+}
+
+TEST(thread_pool_tests, check_parallel_for_does_not_allocate) {
+  ASSERT_TRUE(ppc::core::AllocationTracker::IsInstalled());
+  ppc::core::ThreadPool pool(4);
+  std::vector<std::atomic<int>> visits(1000);
+  auto body = [&](size_t begin, size_t end) {
+    for (size_t i = begin; i < end; i++) {
+      visits[i]++;
+    }
+  };
+
+  // The first loop grows queues of the workers
+  pool.ParallelFor(0, visits.size(), std::ref(body));
+  const auto before = ppc::core::AllocationTracker::Snapshot();
+  for (int i = 0; i < 10; i++) {
+    pool.ParallelFor(0, visits.size(), std::ref(body));
+  }
+  const auto after = ppc::core::AllocationTracker::Snapshot();
+  EXPECT_EQ(after.count, before.count);
+  EXPECT_EQ(visits[0], 11);
+}
@@ -0,0 +1,108 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "core/util/include/topology.hpp"
+
+namespace ppc::core {
+
+// Pool of worker threads with work-stealing queues. Every worker owns a deque:
+// it takes its newest task first, and idle workers steal the oldest tasks of
+// the others. Parallel loops are split into chunks which are spread over the
+// deques, the calling thread runs chunks too, so a pool of num_threads keeps
+// num_threads - 1 workers and nested loops inside tasks don't deadlock.
+// With active pinning the worker i is bound like the thread i + 1 of a parallel
+// runtime, the calling thread keeps its affinity.
+class ThreadPool {
+ public:
+  explicit ThreadPool(int num_threads, ppc::util::Pinning pinning = {});
+  ThreadPool(const ThreadPool &) = delete;
+  ThreadPool &operator=(const ThreadPool &) = delete;
+  ~ThreadPool();
+
+  // Pool of the process sized by ppc::util::GetPPCNumThreads() and pinned by
+  // ppc::util::GetPPCPinning() on the first call, it lives until the exit, so
+  // tasks don't pay for creation of threads
+  static ThreadPool &Global();
+
+  // Number of threads running a loop including the calling one
+  [[nodiscard]] int Size() const { return static_cast<int>(queues_.size()) + 1; }
+
+  // Runs func on a worker, without workers it is run immediately
+  template <class Func>
+  std::future<std::invoke_result_t<Func>> Submit(Func func) {
+    auto task = std::make_shared<std::packaged_task<std::invoke_result_t<Func>()>>(std::move(func));
+    auto result = task->get_future();
+    if (queues_.empty()) {
+      (*task)();
+    } else {
+      Push(next_queue_++ % queues_.size(), [task] { (*task)(); });
+    }
+    return result;
+  }
+
+  // Calls body(chunk_begin, chunk_end) for chunks of [begin, end) of at least
+  // grain elements and waits for all of them, the first exception is rethrown
+  void ParallelFor(size_t begin, size_t end, const std::function<void(size_t, size_t)> &body, size_t grain = 1);
+
+  // Reduces [begin, end): reduce(chunk_begin, chunk_end) computes the result of
+  // a chunk, results are merged by combine(lhs, rhs) from left to right
+  template <class Result, class Reduce, class Combine>
+  Result ParallelReduce(size_t begin, size_t end, const Result &identity, const Reduce &reduce,
+                        const Combine &combine, size_t grain = 1) {
+    const auto num_chunks = NumChunks(end - begin, grain);
+    std::vector<Result> partial(num_chunks, identity);
+    auto chunk_body = [&](size_t chunk) {
+      const auto [chunk_begin, chunk_end] = ChunkBounds(begin, end, num_chunks, chunk);
+      partial[chunk] = reduce(chunk_begin, chunk_end);
+    };
+    RunChunks(num_chunks, std::ref(chunk_body));
+    auto result = identity;
+    for (const auto &value : partial) {
+      result = combine(result, value);
+    }
+    return result;
+  }
+
+ private:
+  using Task = std::function<void()>;
+
+  // Ring buffer of tasks, the oldest one is at head. It grows when it is full
+  // and never shrinks, so repeated loops don't touch the heap
+  struct Queue {
+    std::mutex mutex;
+    std::vector<Task> tasks;
+    size_t head = 0;
+    size_t size = 0;
+  };
+
+  static std::pair<size_t, size_t> ChunkBounds(size_t begin, size_t end, size_t num_chunks, size_t chunk);
+  [[nodiscard]] size_t NumChunks(size_t size, size_t grain) const;
+  void RunChunks(size_t num_chunks, const std::function<void(size_t)> &chunk_body);
+
+  void Push(size_t queue, Task task);
+  bool TryPop(size_t queue, Task &task);
+  bool TrySteal(size_t thief, Task &task);
+  void WorkerLoop(size_t index);
+
+  std::vector<std::unique_ptr<Queue>> queues_;
+  std::vector<std::thread> workers_;
+  ppc::util::Pinning pinning_;
+  std::atomic<size_t> next_queue_ = 0;
+  std::atomic<size_t> num_queued_ = 0;
+  std::mutex sleep_mutex_;
+  std::condition_variable sleep_cv_;
+  bool stop_ = false;
+};
+
+}  // namespace ppc::core
@@ -0,0 +1,196 @@
+#include "core/thread_pool/include/thread_pool.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "core/util/include/topology.hpp"
+#include "core/util/include/util.hpp"
+
+namespace {
+
+// Chunks per thread of a parallel loop, extra chunks let fast threads steal
+// work of slow ones
+constexpr size_t kChunksPerThread = 4;
+// Tasks a queue holds before its first growth
+constexpr size_t kInitialQueueCapacity = 16;
+
+}  // namespace
+
+ppc::core::ThreadPool::ThreadPool(int num_threads, ppc::util::Pinning pinning) : pinning_(std::move(pinning)) {
+  const auto num_workers = static_cast<size_t>(std::max(num_threads - 1, 0));
+  queues_.reserve(num_workers);
+  for (size_t i = 0; i < num_workers; i++) {
+    queues_.emplace_back(std::make_unique<Queue>());
+  }
+  workers_.reserve(num_workers);
+  for (size_t i = 0; i < num_workers; i++) {
+    workers_.emplace_back([this, i] { WorkerLoop(i); });
+  }
+}
+
+ppc::core::ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard lock(sleep_mutex_);
+    stop_ = true;
+  }
+  sleep_cv_.notify_all();
+  for (auto &worker : workers_) {
+    worker.join();
+  }
+}
+
+ppc::core::ThreadPool &ppc::core::ThreadPool::Global() {
+  static ThreadPool pool(std::max(ppc::util::GetPPCNumThreads(), 1), ppc::util::GetPPCPinning());
+  return pool;
+}
+
+void ppc::core::ThreadPool::ParallelFor(size_t begin, size_t end, const std::function<void(size_t, size_t)> &body,
+                                        size_t grain) {
+  if (end <= begin) {
+    return;
+  }
+  const auto num_chunks = NumChunks(end - begin, grain);
+  auto chunk_body = [&](size_t chunk) {
+    const auto [chunk_begin, chunk_end] = ChunkBounds(begin, end, num_chunks, chunk);
+    body(chunk_begin, chunk_end);
+  };
+  // std::ref keeps the loop body out of the heap
+  RunChunks(num_chunks, std::ref(chunk_body));
+}
+
+std::pair<size_t, size_t> ppc::core::ThreadPool::ChunkBounds(size_t begin, size_t end, size_t num_chunks,
+                                                             size_t chunk) {
+  const auto size = end - begin;
+  const auto chunk_begin = begin + (chunk * (size / num_chunks)) + std::min(chunk, size % num_chunks);
+  return {chunk_begin, chunk_begin + (size / num_chunks) + (chunk < size % num_chunks ? 1 : 0)};
+}
+
+size_t ppc::core::ThreadPool::NumChunks(size_t size, size_t grain) const {
+  const auto max_chunks = (size + std::max<size_t>(grain, 1) - 1) / std::max<size_t>(grain, 1);
+  return std::clamp<size_t>(static_cast<size_t>(Size()) * kChunksPerThread, 1, std::max<size_t>(max_chunks, 1));
+}
+
+void ppc::core::ThreadPool::RunChunks(size_t num_chunks, const std::function<void(size_t)> &chunk_body) {
+  if (queues_.empty() || num_chunks == 1) {
+    for (size_t chunk = 0; chunk < num_chunks; chunk++) {
+      chunk_body(chunk);
+    }
+    return;
+  }
+
+  std::atomic<size_t> num_remaining = num_chunks;
+  std::exception_ptr error;
+  std::mutex error_mutex;
+  auto run_chunk = [&](size_t chunk) {
+    try {
+      chunk_body(chunk);
+    } catch (...) {
+      std::lock_guard lock(error_mutex);
+      if (!error) {
+        error = std::current_exception();
+      }
+    }
+    num_remaining--;
+  };
+
+  // The first chunk is left for the calling thread, the others are spread over
+  // the queues of the workers
+  for (size_t chunk = 1; chunk < num_chunks; chunk++) {
+    Push(chunk % queues_.size(), [&run_chunk, chunk] { run_chunk(chunk); });
+  }
+  run_chunk(0);
+
+  // Help the workers until all chunks are done, tasks of other loops may be
+  // taken here too, this keeps nested loops from waiting for busy workers
+  Task task;
+  while (num_remaining > 0) {
+    if (TrySteal(queues_.size(), task)) {
+      task();
+    } else {
+      std::this_thread::yield();
+    }
+  }
+  if (error) {
+    std::rethrow_exception(error);
+  }
+}
+
+void ppc::core::ThreadPool::Push(size_t queue, Task task) {
+  // The counter goes first, so it never drops below zero when the task is taken
+  // right away, and it is changed under the lock to not miss a sleeping worker
+  {
+    std::lock_guard lock(sleep_mutex_);
+    num_queued_++;
+  }
+  {
+    auto &ring = *queues_[queue];
+    std::lock_guard lock(ring.mutex);
+    if (ring.size == ring.tasks.size()) {
+      std::vector<Task> tasks(std::max<size_t>(ring.tasks.size() * 2, kInitialQueueCapacity));
+      for (size_t i = 0; i < ring.size; i++) {
+        tasks[i] = std::move(ring.tasks[(ring.head + i) % ring.tasks.size()]);
+      }
+      ring.tasks = std::move(tasks);
+      ring.head = 0;
+    }
+    ring.tasks[(ring.head + ring.size) % ring.tasks.size()] = std::move(task);
+    ring.size++;
+  }
+  sleep_cv_.notify_one();
+}
+
+bool ppc::core::ThreadPool::TryPop(size_t queue, Task &task) {
+  auto &ring = *queues_[queue];
+  std::lock_guard lock(ring.mutex);
+  if (ring.size == 0) {
+    return false;
+  }
+  auto &newest = ring.tasks[(ring.head + ring.size - 1) % ring.tasks.size()];
+  task = std::move(newest);
+  newest = nullptr;
+  ring.size--;
+  num_queued_--;
+  return true;
+}
+
+bool ppc::core::ThreadPool::TrySteal(size_t thief, Task &task) {
+  for (size_t offset = 1; offset <= queues_.size(); offset++) {
+    auto &victim = *queues_[(thief + offset) % queues_.size()];
+    std::lock_guard lock(victim.mutex);
+    if (victim.size > 0) {
+      auto &oldest = victim.tasks[victim.head];
+      task = std::move(oldest);
+      oldest = nullptr;
+      victim.head = (victim.head + 1) % victim.tasks.size();
+      victim.size--;
+      num_queued_--;
+      return true;
+    }
+  }
+  return false;
+}
+
+void ppc::core::ThreadPool::WorkerLoop(size_t index) {
+  static_cast<void>(pinning_.Pin(static_cast<int>(index) + 1));
+  Task task;
+  while (true) {
+    if (TryPop(index, task) || TrySteal(index, task)) {
+      task();
+      task = nullptr;
+      continue;
+    }
+    std::unique_lock lock(sleep_mutex_);
+    sleep_cv_.wait(lock, [this] { return stop_ || num_queued_ > 0; });
+    if (stop_ && num_queued_ == 0) {
+      return;
+    }
+  }
+}
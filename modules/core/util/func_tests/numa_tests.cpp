@@ -0,0 +1,55 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+#include <span>
+#include <vector>
+
+#include "core/thread_pool/include/thread_pool.hpp"
+#include "core/util/include/numa.hpp"
+
+namespace {
+
+struct Counted {
+  static inline int num_constructed = 0;
+  int value = 7;
+  Counted() { num_constructed++; }
+};
+
+}  // namespace
+
+TEST(numa_tests, check_alignment) {
+  ppc::util::FirstTouchVector<double> big(ppc::util::kPageSize);
+  EXPECT_EQ(reinterpret_cast<uintptr_t>(big.data()) % ppc::util::kPageSize, 0U);
+
+  ppc::util::FirstTouchVector<double> small(3);
+  EXPECT_EQ(reinterpret_cast<uintptr_t>(small.data()) % alignof(double), 0U);
+}
+
+TEST(numa_tests, check_elements_are_default_initialized) {
+  // Non trivial types are still constructed, only trivial ones are left untouched
+  Counted::num_constructed = 0;
+  ppc::util::FirstTouchVector<Counted> values(10);
+  EXPECT_EQ(Counted::num_constructed, 10);
+  EXPECT_EQ(values[9].value, 7);
+
+  ppc::util::FirstTouchVector<int> filled(5, 3);
+  EXPECT_EQ(filled, ppc::util::FirstTouchVector<int>({3, 3, 3, 3, 3}));
+}
+
+TEST(numa_tests, check_first_touch_copy_and_fill) {
+  std::vector<int64_t> source(100000);
+  std::iota(source.begin(), source.end(), 0);
+
+  auto &pool = ppc::core::ThreadPool::Global();
+  auto loop = [&](size_t size, const auto &body) { pool.ParallelFor(0, size, body, 1024); };
+
+  ppc::util::FirstTouchVector<int64_t> copy(source.size());
+  ppc::util::FirstTouchCopy<int64_t>(source, copy, loop);
+  EXPECT_TRUE(std::equal(source.begin(), source.end(), copy.begin(), copy.end()));
+
+  ppc::util::FirstTouchFill<int64_t>(copy, -1, loop);
+  EXPECT_EQ(std::count(copy.begin(), copy.end(), -1), static_cast<std::ptrdiff_t>(copy.size()));
+}
@@ -0,0 +1,142 @@
+#include <gtest/gtest.h>
+
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "core/util/include/topology.hpp"
+
+#ifdef __linux__
+#include <sched.h>
+#endif
+
+namespace {
+
+// Two packages with two cores of two SMT siblings each, every package is a
+// NUMA node, siblings are numbered like Linux does: cpu 0 and cpu 4 share a core
+std::filesystem::path MakeFakeSysfs() {
+  const auto root = std::filesystem::temp_directory_path() / "ppc_topology_tests";
+  std::filesystem::remove_all(root);
+  auto write = [&](const std::filesystem::path &path, const std::string &value) {
+    std::filesystem::create_directories((root / path).parent_path());
+    std::ofstream(root / path) << value << '\n';
+  };
+  write("cpu/online", "0-7");
+  for (int cpu = 0; cpu < 8; cpu++) {
+    const auto dir = std::filesystem::path("cpu") / ("cpu" + std::to_string(cpu)) / "topology";
+    write(dir / "core_id", std::to_string(cpu % 2));
+    write(dir / "physical_package_id", std::to_string((cpu / 2) % 2));
+  }
+  write("node/node0/cpulist", "0-1,4-5");
+  write("node/node1/cpulist", "2-3,6-7");
+  write("node/possible", "0-1");
+  return root;
+}
+
+}  // namespace
+
+TEST(topology_tests, check_detect) {
+  const auto topology = ppc::util::Topology::Detect(MakeFakeSysfs().string());
+  ASSERT_EQ(topology.Cpus().size(), 8U);
+  EXPECT_EQ(topology.NumCores(), 4);
+  EXPECT_EQ(topology.NumNumaNodes(), 2);
+  EXPECT_EQ(topology.Cpus()[6].core, 0);
+  EXPECT_EQ(topology.Cpus()[6].package, 1);
+  EXPECT_EQ(topology.Cpus()[6].numa_node, 1);
+}
+
+TEST(topology_tests, check_detect_without_sysfs) {
+  const auto topology = ppc::util::Topology::Detect("/nonexistent/ppc/sysfs");
+  EXPECT_EQ(topology.Cpus().size(), std::max(std::thread::hardware_concurrency(), 1U));
+  EXPECT_EQ(topology.NumNumaNodes(), 1);
+}
+
+TEST(topology_tests, check_policies) {
+  const auto topology = ppc::util::Topology::Detect(MakeFakeSysfs().string());
+  using Cpus = std::vector<std::vector<int>>;
+
+  const auto compact = ppc::util::MakePinning(topology, ppc::util::PinPolicy::kCompact, 4);
+  EXPECT_EQ(compact.cpus, (Cpus{{0}, {4}, {1}, {5}}));
+
+  const auto scatter = ppc::util::MakePinning(topology, ppc::util::PinPolicy::kScatter, 4);
+  EXPECT_EQ(scatter.cpus, (Cpus{{0}, {2}, {1}, {3}}));
+
+  const auto numa = ppc::util::MakePinning(topology, ppc::util::PinPolicy::kNuma, 3);
+  EXPECT_EQ(numa.cpus, (Cpus{{0, 4, 1, 5}, {0, 4, 1, 5}, {2, 6, 3, 7}}));
+  EXPECT_EQ(numa.OmpPlaces(), "{0,4,1,5},{0,4,1,5},{2,6,3,7}");
+
+  const auto none = ppc::util::MakePinning(topology, ppc::util::PinPolicy::kNone, 4);
+  EXPECT_FALSE(none.IsActive());
+  EXPECT_FALSE(none.Pin(0));
+  EXPECT_EQ(none.ToString(), "policy=none");
+}
+
+TEST(topology_tests, check_more_threads_than_cpus) {
+  const auto topology = ppc::util::Topology::Detect(MakeFakeSysfs().string());
+  const auto scatter = ppc::util::MakePinning(topology, ppc::util::PinPolicy::kScatter, 10);
+  ASSERT_EQ(scatter.cpus.size(), 10U);
+  EXPECT_EQ(scatter.cpus[8], scatter.cpus[0]);
+  EXPECT_EQ(scatter.ToString().rfind("policy=scatter;places={0},{2},{1},{3},{4},{6},{5},{7},{0},{2}", 0), 0U);
+}
+
+TEST(topology_tests, check_policy_from_env) {
+#ifndef _WIN32
+  setenv("PPC_PIN_POLICY", "scatter", 1);  // NOLINT(misc-include-cleaner)
+  EXPECT_EQ(ppc::util::GetPPCPinPolicy(), ppc::util::PinPolicy::kScatter);
+  setenv("PPC_PIN_POLICY", "unknown", 1);  // NOLINT(misc-include-cleaner)
+  EXPECT_EQ(ppc::util::GetPPCPinPolicy(), ppc::util::PinPolicy::kNone);
+  unsetenv("PPC_PIN_POLICY");  // NOLINT(misc-include-cleaner)
+  EXPECT_EQ(ppc::util::GetPPCPinPolicy(), ppc::util::PinPolicy::kNone);
+#else
+  GTEST_SKIP();
+#endif
+}
+
+TEST(topology_tests, check_description_of_requested_pinning) {
+#ifndef _WIN32
+  EXPECT_EQ(ppc::util::DescribePPCPinning(), "");
+  setenv("PPC_PIN_POLICY", "compact", 1);  // NOLINT(misc-include-cleaner)
+  setenv("OMP_PROC_BIND", "spread", 1);    // NOLINT(misc-include-cleaner)
+  const auto description = ppc::util::DescribePPCPinning();
+  unsetenv("PPC_PIN_POLICY");  // NOLINT(misc-include-cleaner)
+  unsetenv("OMP_PROC_BIND");   // NOLINT(misc-include-cleaner)
+  if (ppc::util::Topology::System().Cpus().empty()) {
+    GTEST_SKIP();
+  }
+  EXPECT_EQ(description.rfind("requested;policy=compact;places=", 0), 0U);
+  EXPECT_NE(description.find(";OMP_PROC_BIND=spread"), std::string::npos);
+#else
+  GTEST_SKIP();
+#endif
+}
+
+TEST(topology_tests, check_pin_current_thread) {
+#ifdef __linux__
+  // The current CPU is always allowed, so pinning to it has to succeed
+  const int cpu = sched_getcpu();
+  ASSERT_GE(cpu, 0);
+  bool pinned = false;
+  std::thread([&] { pinned = ppc::util::PinCurrentThread({cpu}); }).join();
+  EXPECT_TRUE(pinned);
+#else
+  GTEST_SKIP();
+#endif
+}
+
+TEST(topology_tests, check_mask_of_current_thread_is_restored) {
+#ifdef __linux__
+  std::thread([] {
+    const auto cpus = ppc::util::CurrentThreadCpus();
+    ASSERT_FALSE(cpus.empty());
+    ASSERT_TRUE(ppc::util::PinCurrentThread({sched_getcpu()}));
+    EXPECT_EQ(ppc::util::CurrentThreadCpus().size(), 1U);
+    ASSERT_TRUE(ppc::util::PinCurrentThread(cpus));
+    EXPECT_EQ(ppc::util::CurrentThreadCpus(), cpus);
+  }).join();
+#else
+  GTEST_SKIP();
+#endif
+}
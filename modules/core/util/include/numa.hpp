@@ -0,0 +1,72 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <new>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace ppc::util {
+
+constexpr size_t kPageSize = 4096;
+
+// Allocator which leaves allocated memory untouched: elements are default
+// initialized, so pages of trivial types are placed on the NUMA node of the
+// thread which writes them first (the first-touch policy of the OS). Buffers
+// of a page and more are page aligned, so chunks of different threads share
+// as few pages as possible.
+template <class T>
+class FirstTouchAllocator {
+ public:
+  using value_type = T;
+
+  FirstTouchAllocator() = default;
+  template <class U>
+  FirstTouchAllocator(const FirstTouchAllocator<U> & /*other*/) noexcept {}  // NOLINT(google-explicit-constructor)
+
+  T *allocate(size_t count) { return static_cast<T *>(::operator new(count * sizeof(T), Alignment(count))); }
+  void deallocate(T *ptr, size_t count) noexcept { ::operator delete(ptr, count * sizeof(T), Alignment(count)); }
+
+  template <class U, class... Args>
+  void construct(U *ptr, Args &&...args) {
+    if constexpr (sizeof...(Args) == 0) {
+      ::new (static_cast<void *>(ptr)) U;
+    } else {
+      ::new (static_cast<void *>(ptr)) U(std::forward<Args>(args)...);
+    }
+  }
+
+  template <class U>
+  bool operator==(const FirstTouchAllocator<U> & /*other*/) const noexcept {
+    return true;
+  }
+
+ private:
+  static std::align_val_t Alignment(size_t count) {
+    return std::align_val_t{count * sizeof(T) >= kPageSize ? std::max(kPageSize, alignof(T)) : alignof(T)};
+  }
+};
+
+template <class T>
+using FirstTouchVector = std::vector<T, FirstTouchAllocator<T>>;
+
+// Copies source to destination with loop(size, body), where body(begin, end)
+// copies a chunk. The loop has to split the range between threads the same way
+// as the kernel which processes the data, then every page lands on the node of
+// the thread which reads it later.
+template <class T, class Loop>
+void FirstTouchCopy(std::span<const T> source, std::span<T> destination, const Loop &loop) {
+  loop(source.size(), [&](size_t begin, size_t end) {
+    std::copy(source.begin() + begin, source.begin() + end, destination.begin() + begin);
+  });
+}
+
+// Fills destination with value chunk by chunk like FirstTouchCopy
+template <class T, class Loop>
+void FirstTouchFill(std::span<T> destination, const T &value, const Loop &loop) {
+  loop(destination.size(),
+       [&](size_t begin, size_t end) { std::fill(destination.begin() + begin, destination.begin() + end, value); });
+}
+
+}  // namespace ppc::util
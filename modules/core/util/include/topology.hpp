@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace ppc::util {
+
+// Hardware thread of the machine
+struct LogicalCpu {
+  int id = 0;
+  int core = 0;
+  int package = 0;
+  int numa_node = 0;
+};
+
+// Cores, SMT siblings and NUMA nodes of the machine. On Linux they are read
+// from sysfs, elsewhere (or if sysfs is not readable) every hardware thread is
+// treated as a separate core of a single node.
+class Topology {
+ public:
+  // Reads the topology from sysfs_root, usually /sys/devices/system
+  static Topology Detect(const std::string &sysfs_root = "/sys/devices/system");
+  // Topology of this machine limited to CPUs the process may run on, detected
+  // on the first call
+  static const Topology &System();
+
+  // Online hardware threads ordered by id
+  [[nodiscard]] const std::vector<LogicalCpu> &Cpus() const { return cpus_; }
+  [[nodiscard]] int NumCores() const;
+  [[nodiscard]] int NumNumaNodes() const;
+
+ private:
+  std::vector<LogicalCpu> cpus_;
+};
+
+// How threads are placed on hardware threads:
+//   kCompact - neighbouring threads share cores and nodes, SMT siblings first
+//   kScatter - threads are spread over nodes and cores, SMT siblings last
+//   kNuma    - threads are bound to whole NUMA nodes in equal blocks
+enum class PinPolicy : uint8_t { kNone, kCompact, kScatter, kNuma };
+
+const char *PinPolicyName(PinPolicy policy);
+
+// Hardware threads allowed for every thread of a parallel runtime, the thread
+// with index i runs on cpus[i % cpus.size()]
+struct Pinning {
+  PinPolicy policy = PinPolicy::kNone;
+  std::vector<std::vector<int>> cpus;
+
+  [[nodiscard]] bool IsActive() const { return policy != PinPolicy::kNone && !cpus.empty(); }
+  // Binds the calling thread, returns false if pinning is off or not supported
+  [[nodiscard]] bool Pin(int thread_index) const;
+  // Places in OMP_PLACES format, e.g. "{0},{2},{1,3}"
+  [[nodiscard]] std::string OmpPlaces() const;
+  // Requested mapping for logs, e.g. "policy=scatter;places={0},{2}"
+  [[nodiscard]] std::string ToString() const;
+};
+
+Pinning MakePinning(const Topology &topology, PinPolicy policy, int num_threads);
+
+// Policy from PPC_PIN_POLICY (compact, scatter or numa), threads are not
+// pinned by default
+PinPolicy GetPPCPinPolicy();
+// Pinning of GetPPCNumThreads() threads with GetPPCPinPolicy() on this machine
+Pinning GetPPCPinning();
+// GetPPCPinning() for logs, it's the requested mapping: threads of OpenMP keep
+// the binding of OMP_PROC_BIND and OMP_PLACES, so they are added when set, e.g.
+// "requested;policy=compact;places={0},{1};OMP_PROC_BIND=close". Empty if off
+std::string DescribePPCPinning();
+
+// Binds the calling thread to given hardware threads (Linux only)
+bool PinCurrentThread(const std::vector<int> &cpus);
+// Hardware threads allowed for the calling thread, empty if unknown (Linux only).
+// Runtimes which bind a thread they don't own give it this mask back
+std::vector<int> CurrentThreadCpus();
+
+}  // namespace ppc::util
@@ -1,9 +1,23 @@
 #pragma once
+#include <cstddef>
 #include <string>
 
 namespace ppc::util {
 
 std::string GetAbsolutePath(const std::string &relative_path);
 int GetPPCNumThreads();
+// Value of the environment variable, empty if it is not set
+std::string GetEnv(const char *name);
+// Multiplier of the work of perf tests for weak scaling runs, PPC_WORK_SCALE
+// (1 if it is not set)
+double GetPPCWorkScale();
+// Size of a perf test whose work grows as size^work_exponent, it is scaled so
+// that the work grows GetPPCWorkScale() times
+size_t ScaledPerfSize(size_t base_size, double work_exponent);
+// Time limit (in seconds) from the environment variable, fallback if it is not
+// set or not positive
+double GetPPCTimeLimit(const char *name, double fallback);
+// PPC_SOFT_TIME_LIMITS=1 reports overruns of time limits as warnings
+bool GetPPCSoftTimeLimits();
 
 }  // namespace ppc::util
@@ -0,0 +1,295 @@
+#include "core/util/include/topology.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <set>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "core/util/include/util.hpp"
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace {
+
+std::string ReadLine(const std::filesystem::path &path) {
+  std::ifstream file(path);
+  std::string line;
+  std::getline(file, line);
+  return line;
+}
+
+int ReadInt(const std::filesystem::path &path, int fallback) {
+  const auto line = ReadLine(path);
+  return line.empty() ? fallback : std::atoi(line.c_str());
+}
+
+// Parses lists like "0-3,8,10-11"
+std::vector<int> ParseCpuList(const std::string &list) {
+  std::vector<int> cpus;
+  std::stringstream stream(list);
+  std::string range;
+  while (std::getline(stream, range, ',')) {
+    if (range.empty()) {
+      continue;
+    }
+    const auto dash = range.find('-');
+    const int first = std::atoi(range.substr(0, dash).c_str());
+    const int last = dash == std::string::npos ? first : std::atoi(range.substr(dash + 1).c_str());
+    for (int cpu = first; cpu <= last; cpu++) {
+      cpus.push_back(cpu);
+    }
+  }
+  return cpus;
+}
+
+// Hardware threads ordered so that the first n of them are the placement of
+// n threads with given policy
+std::vector<ppc::util::LogicalCpu> OrderCpus(std::vector<ppc::util::LogicalCpu> cpus, ppc::util::PinPolicy policy) {
+  using ppc::util::LogicalCpu;
+  auto compact_key = [](const LogicalCpu &cpu) { return std::tuple(cpu.numa_node, cpu.package, cpu.core, cpu.id); };
+  std::ranges::sort(cpus, [&](const LogicalCpu &lhs, const LogicalCpu &rhs) {
+    return compact_key(lhs) < compact_key(rhs);
+  });
+  if (policy != ppc::util::PinPolicy::kScatter) {
+    return cpus;
+  }
+
+  // Rank of a hardware thread among its SMT siblings and rank of its core in
+  // its node, threads take the first sibling of every core of every node first
+  std::map<std::pair<int, int>, int> num_siblings;
+  std::map<int, std::set<std::pair<int, int>>> node_cores;
+  std::map<int, std::tuple<int, int, int, int>> scatter_key;
+  for (const auto &cpu : cpus) {
+    const auto core = std::pair(cpu.package, cpu.core);
+    node_cores[cpu.numa_node].insert(core);
+    const auto core_rank = static_cast<int>(node_cores[cpu.numa_node].size()) - 1;
+    scatter_key[cpu.id] = std::tuple(num_siblings[core]++, core_rank, cpu.numa_node, cpu.id);
+  }
+  std::ranges::sort(cpus, [&](const LogicalCpu &lhs, const LogicalCpu &rhs) {
+    return scatter_key[lhs.id] < scatter_key[rhs.id];
+  });
+  return cpus;
+}
+
+}  // namespace
+
+ppc::util::Topology ppc::util::Topology::Detect(const std::string &sysfs_root) {
+  const std::filesystem::path root(sysfs_root);
+  Topology topology;
+  auto online = ParseCpuList(ReadLine(root / "cpu" / "online"));
+  if (online.empty()) {
+    for (int cpu = 0; cpu < static_cast<int>(std::max(std::thread::hardware_concurrency(), 1U)); cpu++) {
+      topology.cpus_.push_back({.id = cpu, .core = cpu, .package = 0, .numa_node = 0});
+    }
+    return topology;
+  }
+
+  for (const int id : online) {
+    const auto cpu_dir = root / "cpu" / ("cpu" + std::to_string(id)) / "topology";
+    topology.cpus_.push_back({.id = id,
+                              .core = ReadInt(cpu_dir / "core_id", id),
+                              .package = ReadInt(cpu_dir / "physical_package_id", 0),
+                              .numa_node = 0});
+  }
+
+  std::error_code error;
+  for (const auto &entry : std::filesystem::directory_iterator(root / "node", error)) {
+    const auto name = entry.path().filename().string();
+    if (name.rfind("node", 0) != 0 || name.size() == 4 ||
+        !std::all_of(name.begin() + 4, name.end(), [](char c) { return c >= '0' && c <= '9'; })) {
+      continue;
+    }
+    const int node = std::atoi(name.c_str() + 4);
+    for (const int id : ParseCpuList(ReadLine(entry.path() / "cpulist"))) {
+      auto cpu = std::ranges::find(topology.cpus_, id, &LogicalCpu::id);
+      if (cpu != topology.cpus_.end()) {
+        cpu->numa_node = node;
+      }
+    }
+  }
+  std::ranges::sort(topology.cpus_, {}, &LogicalCpu::id);
+  return topology;
+}
+
+const ppc::util::Topology &ppc::util::Topology::System() {
+  static const Topology kTopology = [] {
+    auto topology = Detect();
+#ifdef __linux__
+    // CPUs outside of the affinity mask of the process (cgroups, taskset) can't be used for pinning
+    cpu_set_t allowed;
+    CPU_ZERO(&allowed);
+    if (sched_getaffinity(0, sizeof(allowed), &allowed) == 0) {
+      auto usable = topology.cpus_;
+      std::erase_if(usable,
+                    [&](const LogicalCpu &cpu) { return cpu.id >= CPU_SETSIZE || !CPU_ISSET(cpu.id, &allowed); });
+      if (!usable.empty()) {
+        topology.cpus_ = std::move(usable);
+      }
+    }
+#endif
+    return topology;
+  }();
+  return kTopology;
+}
+
+int ppc::util::Topology::NumCores() const {
+  std::set<std::pair<int, int>> cores;
+  for (const auto &cpu : cpus_) {
+    cores.emplace(cpu.package, cpu.core);
+  }
+  return static_cast<int>(cores.size());
+}
+
+int ppc::util::Topology::NumNumaNodes() const {
+  std::set<int> nodes;
+  for (const auto &cpu : cpus_) {
+    nodes.insert(cpu.numa_node);
+  }
+  return static_cast<int>(nodes.size());
+}
+
+const char *ppc::util::PinPolicyName(PinPolicy policy) {
+  switch (policy) {
+    case PinPolicy::kCompact:
+      return "compact";
+    case PinPolicy::kScatter:
+      return "scatter";
+    case PinPolicy::kNuma:
+      return "numa";
+    case PinPolicy::kNone:
+      break;
+  }
+  return "none";
+}
+
+bool ppc::util::Pinning::Pin(int thread_index) const {
+  if (!IsActive() || thread_index < 0) {
+    return false;
+  }
+  return PinCurrentThread(cpus[static_cast<size_t>(thread_index) % cpus.size()]);
+}
+
+std::string ppc::util::Pinning::OmpPlaces() const {
+  std::stringstream places;
+  for (size_t thread = 0; thread < cpus.size(); thread++) {
+    places << (thread > 0 ? "," : "") << "{";
+    for (size_t i = 0; i < cpus[thread].size(); i++) {
+      places << (i > 0 ? "," : "") << cpus[thread][i];
+    }
+    places << "}";
+  }
+  return places.str();
+}
+
+std::string ppc::util::Pinning::ToString() const {
+  std::string result = std::string("policy=") + PinPolicyName(policy);
+  if (IsActive()) {
+    result += ";places=" + OmpPlaces();
+  }
+  return result;
+}
+
+ppc::util::Pinning ppc::util::MakePinning(const Topology &topology, PinPolicy policy, int num_threads) {
+  Pinning pinning{.policy = policy, .cpus = {}};
+  if (policy == PinPolicy::kNone || topology.Cpus().empty() || num_threads <= 0) {
+    return pinning;
+  }
+
+  const auto ordered = OrderCpus(topology.Cpus(), policy);
+  if (policy == PinPolicy::kNuma) {
+    std::map<int, std::vector<int>> node_cpus;
+    for (const auto &cpu : ordered) {
+      node_cpus[cpu.numa_node].push_back(cpu.id);
+    }
+    std::vector<std::vector<int>> nodes;
+    for (auto &[node, cpus] : node_cpus) {
+      nodes.emplace_back(std::move(cpus));
+    }
+    for (int thread = 0; thread < num_threads; thread++) {
+      pinning.cpus.push_back(nodes[static_cast<size_t>(thread) * nodes.size() / static_cast<size_t>(num_threads)]);
+    }
+    return pinning;
+  }
+
+  for (int thread = 0; thread < num_threads; thread++) {
+    pinning.cpus.push_back({ordered[static_cast<size_t>(thread) % ordered.size()].id});
+  }
+  return pinning;
+}
+
+ppc::util::PinPolicy ppc::util::GetPPCPinPolicy() {
+  const auto name = ppc::util::GetEnv("PPC_PIN_POLICY");
+  for (const auto policy : {PinPolicy::kCompact, PinPolicy::kScatter, PinPolicy::kNuma}) {
+    if (name == PinPolicyName(policy)) {
+      return policy;
+    }
+  }
+  return PinPolicy::kNone;
+}
+
+ppc::util::Pinning ppc::util::GetPPCPinning() {
+  return MakePinning(Topology::System(), GetPPCPinPolicy(), std::max(GetPPCNumThreads(), 1));
+}
+
+std::string ppc::util::DescribePPCPinning() {
+  const auto pinning = GetPPCPinning();
+  if (!pinning.IsActive()) {
+    return {};
+  }
+  std::string result = "requested;" + pinning.ToString();
+  for (const char *name : {"OMP_PROC_BIND", "OMP_PLACES"}) {
+    const auto value = GetEnv(name);
+    if (!value.empty()) {
+      result += std::string(";") + name + "=" + value;
+    }
+  }
+  return result;
+}
+
+bool ppc::util::PinCurrentThread(const std::vector<int> &cpus) {
+#ifdef __linux__
+  if (cpus.empty()) {
+    return false;
+  }
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  for (const int cpu : cpus) {
+    if (cpu >= 0 && cpu < CPU_SETSIZE) {
+      CPU_SET(cpu, &set);
+    }
+  }
+  return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#else
+  static_cast<void>(cpus);
+  return false;
+#endif
+}
+
+std::vector<int> ppc::util::CurrentThreadCpus() {
+  std::vector<int> cpus;
+#ifdef __linux__
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  if (pthread_getaffinity_np(pthread_self(), sizeof(set), &set) != 0) {
+    return cpus;
+  }
+  for (int cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+    if (CPU_ISSET(cpu, &set)) {
+      cpus.push_back(cpu);
+    }
+  }
+#endif
+  return cpus;
+}
@@ -8,6 +8,9 @@
 #include <vector>
 #endif
 
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
 #include <filesystem>
 #include <string>
 
@@ -30,3 +33,34 @@ int ppc::util::GetPPCNumThreads() {
   int num_threads = (omp_env != nullptr) ? std::atoi(omp_env) : 1;
   return num_threads;
 }
+
+std::string ppc::util::GetEnv(const char *name) {
+#ifdef _WIN32
+  size_t len;
+  char value[100];
+  errno_t err = getenv_s(&len, value, sizeof(value), name);
+  return (err != 0 || len == 0) ? std::string() : std::string(value);
+#else
+  const char *value = std::getenv(name);
+  return value != nullptr ? std::string(value) : std::string();
+#endif
+}
+
+double ppc::util::GetPPCWorkScale() {
+  const auto value = GetEnv("PPC_WORK_SCALE");
+  const double scale = value.empty() ? 1.0 : std::atof(value.c_str());
+  return scale > 0.0 ? scale : 1.0;
+}
+
+size_t ppc::util::ScaledPerfSize(size_t base_size, double work_exponent) {
+  const auto scale = std::pow(GetPPCWorkScale(), 1.0 / work_exponent);
+  return std::max<size_t>(static_cast<size_t>(std::llround(static_cast<double>(base_size) * scale)), 1);
+}
+
+double ppc::util::GetPPCTimeLimit(const char *name, double fallback) {
+  const auto value = GetEnv(name);
+  const double limit = value.empty() ? 0.0 : std::atof(value.c_str());
+  return limit > 0.0 ? limit : fallback;
+}
+
+bool ppc::util::GetPPCSoftTimeLimits() { return std::atoi(GetEnv("PPC_SOFT_TIME_LIMITS").c_str()) != 0; }
@@ -1,25 +1,29 @@
 #ifndef MODULES_REFERENCE_AVERAGE_OF_VECTOR_ELEMENTS_REF_TASK_HPP_
 #define MODULES_REFERENCE_AVERAGE_OF_VECTOR_ELEMENTS_REF_TASK_HPP_
 
+#include <cstddef>
+#include <functional>
 #include <memory>
 #include <numeric>
+#include <span>
 #include <vector>
 
 #include "core/task/include/task.hpp"
+#include "core/util/include/numa.hpp"
+#include "ref/common/include/reduce.hpp"
 
 namespace ppc::reference {
 
 template <class InType, class OutType>
 class AverageOfVectorElements : public ppc::core::Task {
  public:
-  explicit AverageOfVectorElements(ppc::core::TaskDataPtr task_data) : Task(task_data) {}
+  explicit AverageOfVectorElements(ppc::core::TaskDataPtr task_data,
+                                   ppc::core::InputMode input_mode = ppc::core::InputMode::kCopy,
+                                   Backend backend = Backend::kSeq)
+      : Task(task_data), input_mode_(input_mode), backend_(backend) {}
   bool PreProcessingImpl() override {
     // Init vectors
-    input_ = std::vector<InType>(task_data->inputs_count[0]);
-    auto tmp_ptr = reinterpret_cast<InType*>(task_data->inputs[0]);
-    for (unsigned i = 0; i < task_data->inputs_count[0]; i++) {
-      input_[i] = tmp_ptr[i];
-    }
+    input_ = ppc::core::PrepareInput(*task_data, 0, input_mode_, input_storage_, FirstTouchLoop(backend_));
     // Init value for output
     average_ = 0.0;
     return true;
@@ -27,22 +31,29 @@ class AverageOfVectorElements : public ppc::core::Task {
 
   bool ValidationImpl() override {
     // Check count elements of output
-    return task_data->outputs_count[0] == 1;
+    return task_data->NumOutputs() == 1 && task_data->Output<OutType>(0).size() == 1 && IsBackendAvailable(backend_);
   }
 
   bool RunImpl() override {
-    average_ = static_cast<OutType>(std::accumulate(input_.begin(), input_.end(), 0.0));
-    average_ /= static_cast<OutType>(task_data->inputs_count[0]);
+    auto reduce = [&](size_t begin, size_t end) {
+      auto chunk = input_.subspan(begin, end - begin);
+      return std::accumulate(chunk.begin(), chunk.end(), 0.0);
+    };
+    average_ = static_cast<OutType>(ChunkedReduce(backend_, Scratch(), input_.size(), 0.0, reduce, std::plus<>()));
+    average_ /= static_cast<OutType>(input_.size());
     return true;
   }
 
   bool PostProcessingImpl() override {
-    reinterpret_cast<OutType*>(task_data->outputs[0])[0] = average_;
+    task_data->Output<OutType>(0)[0] = average_;
     return true;
   }
 
  private:
-  std::vector<InType> input_;
+  ppc::core::InputMode input_mode_;
+  Backend backend_;
+  ppc::util::FirstTouchVector<InType> input_storage_;
+  std::span<const InType> input_;
   OutType average_;
 };
 
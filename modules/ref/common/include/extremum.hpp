@@ -0,0 +1,45 @@
+#ifndef MODULES_REFERENCE_COMMON_EXTREMUM_HPP_
+#define MODULES_REFERENCE_COMMON_EXTREMUM_HPP_
+
+#include <cstddef>
+#include <limits>
+#include <span>
+
+#include "ref/common/include/reduce.hpp"
+
+namespace ppc::reference {
+
+// Element with the best value and its position
+template <class T>
+struct Extremum {
+  T value{};
+  size_t index = std::numeric_limits<size_t>::max();
+
+  [[nodiscard]] bool IsFound() const { return index != std::numeric_limits<size_t>::max(); }
+};
+
+// Finds the first element which is the best one according to better(lhs, rhs),
+// so std::less<>() gives the same result as std::min_element
+template <class T, class Better>
+Extremum<T> FindExtremum(std::span<const T> input, Backend backend, ppc::core::ScratchArena& scratch, Better better) {
+  using Result = Extremum<T>;
+
+  auto reduce = [&](size_t begin, size_t end) {
+    Result result;
+    for (size_t i = begin; i < end; i++) {
+      if (!result.IsFound() || better(input[i], result.value)) {
+        result = {.value = input[i], .index = i};
+      }
+    }
+    return result;
+  };
+  auto combine = [&](const Result& lhs, const Result& rhs) {
+    return (rhs.IsFound() && (!lhs.IsFound() || better(rhs.value, lhs.value))) ? rhs : lhs;
+  };
+
+  return ChunkedReduce(backend, scratch, input.size(), Result{}, reduce, combine);
+}
+
+}  // namespace ppc::reference
+
+#endif  // MODULES_REFERENCE_COMMON_EXTREMUM_HPP_
@@ -0,0 +1,70 @@
+#ifndef MODULES_REFERENCE_COMMON_NEIGHBOR_PAIR_HPP_
+#define MODULES_REFERENCE_COMMON_NEIGHBOR_PAIR_HPP_
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdlib>
+#include <limits>
+#include <span>
+#include <utility>
+
+#include "ref/common/include/reduce.hpp"
+
+namespace ppc::reference {
+
+// Pair (index, index + 1) of neighbouring elements with the best difference
+template <class DiffType>
+struct NeighborPair {
+  DiffType diff{};
+  size_t index = std::numeric_limits<size_t>::max();
+
+  [[nodiscard]] bool IsFound() const { return index != std::numeric_limits<size_t>::max(); }
+};
+
+// Finds the first pair of neighbours whose |input[i] - input[i + 1]| is the best
+// one according to better(lhs, rhs). Pairs are scanned in one pass without
+// temporary arrays: every block is reduced by a branch-free loop, which is
+// vectorized by the compiler, and only the block holding a new best value is
+// rescanned for its index while it is still in L1. Parallel backends split
+// pairs into chunks, a chunk reads one element past its end, so pairs on the
+// chunk boundaries are covered
+template <class T, class Better>
+auto FindNeighborPair(std::span<const T> input, Backend backend, ppc::core::ScratchArena& scratch, Better better) {
+  using DiffType = decltype(std::abs(input[0] - input[0]));
+  using Result = NeighborPair<DiffType>;
+  constexpr size_t kBlockSize = 256;
+
+  auto diff = [&](size_t i) { return std::abs(input[i] - input[i + 1]); };
+  auto reduce = [&](size_t begin, size_t end) {
+    Result result;
+    for (size_t block_begin = begin; block_begin < end; block_begin += kBlockSize) {
+      const auto block_end = std::min(block_begin + kBlockSize, end);
+      auto block_best = diff(block_begin);
+      for (size_t i = block_begin + 1; i < block_end; i++) {
+        const auto current = diff(i);
+        block_best = better(current, block_best) ? current : block_best;
+      }
+      if (result.IsFound() && !better(block_best, result.diff)) {
+        continue;
+      }
+      for (size_t i = block_begin; i < block_end; i++) {
+        if (diff(i) == block_best) {
+          result = {.diff = block_best, .index = i};
+          break;
+        }
+      }
+    }
+    return result;
+  };
+  auto combine = [&](const Result& lhs, const Result& rhs) {
+    return (rhs.IsFound() && (!lhs.IsFound() || better(rhs.diff, lhs.diff))) ? rhs : lhs;
+  };
+
+  const auto num_pairs = input.size() < 2 ? 0 : input.size() - 1;
+  return ChunkedReduce(backend, scratch, num_pairs, Result{}, reduce, combine);
+}
+
+}  // namespace ppc::reference
+
+#endif  // MODULES_REFERENCE_COMMON_NEIGHBOR_PAIR_HPP_
@@ -0,0 +1,194 @@
+#ifndef MODULES_REFERENCE_COMMON_REDUCE_HPP_
+#define MODULES_REFERENCE_COMMON_REDUCE_HPP_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <numeric>
+#include <span>
+#include <utility>
+#include <version>
+
+#include "core/task/include/scratch_arena.hpp"
+#include "core/thread_pool/include/thread_pool.hpp"
+#include "core/util/include/util.hpp"
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#ifdef USE_TBB
+#include <oneapi/tbb/blocked_range.h>
+#include <oneapi/tbb/parallel_reduce.h>
+#endif
+
+// libstdc++ runs parallel algorithms on top of TBB, so they need it to be linked
+#if defined(__cpp_lib_execution) && (defined(USE_TBB) || !defined(__GLIBCXX__))
+#define PPC_REFERENCE_PAR_UNSEQ
+#include <execution>
+#endif
+
+namespace ppc::reference {
+
+// Execution backend of reference kernels
+enum class Backend : uint8_t { kSeq, kParUnseq, kOmp, kTbb, kStdThread };
+
+inline bool IsBackendAvailable(Backend backend) {
+  switch (backend) {
+    case Backend::kParUnseq:
+#ifdef PPC_REFERENCE_PAR_UNSEQ
+      return true;
+#else
+      return false;
+#endif
+    case Backend::kOmp:
+#ifdef _OPENMP
+      return true;
+#else
+      return false;
+#endif
+    case Backend::kTbb:
+#ifdef USE_TBB
+      return true;
+#else
+      return false;
+#endif
+    case Backend::kSeq:
+    case Backend::kStdThread:
+      return true;
+  }
+  return false;
+}
+
+// Bounds of the chunk with given number when [0, size) is split into num_chunks
+// almost equal parts
+inline std::pair<size_t, size_t> ChunkBounds(size_t size, size_t num_chunks, size_t chunk) {
+  const auto base = size / num_chunks;
+  const auto rest = size % num_chunks;
+  const auto begin = (chunk * base) + std::min(chunk, rest);
+  return {begin, begin + base + (chunk < rest ? 1 : 0)};
+}
+
+// Partial results of num_chunks chunks set to identity, they are taken from the
+// scratch arena, so repeated runs of a task don't touch the heap
+template <class Result>
+std::span<Result> InitPartials(ppc::core::ScratchArena& scratch, size_t num_chunks, const Result& identity) {
+  auto partial = scratch.Allocate<Result>(num_chunks);
+  std::uninitialized_fill(partial.begin(), partial.end(), identity);
+  return partial;
+}
+
+// Reduces [0, size): reduce(begin, end) computes the result of a chunk and
+// combine(lhs, rhs) merges results of neighbouring chunks, left one first, so
+// it has to be associative but not commutative. [0, size) is split into
+// ppc::util::GetPPCNumThreads() chunks, their results live in scratch (pass
+// Task::Scratch() from Run()), std threads are workers of ThreadPool::Global()
+template <class Result, class Reduce, class Combine>
+Result ChunkedReduce(Backend backend, ppc::core::ScratchArena& scratch, size_t size, const Result& identity,
+                     const Reduce& reduce, const Combine& combine) {
+  const auto num_chunks = std::clamp<size_t>(ppc::util::GetPPCNumThreads(), 1, std::max<size_t>(size, 1));
+  auto fold = [&](std::span<const Result> partial) {
+    auto result = identity;
+    for (const auto& value : partial) {
+      result = combine(result, value);
+    }
+    return result;
+  };
+
+  switch (backend) {
+    case Backend::kParUnseq: {
+#ifdef PPC_REFERENCE_PAR_UNSEQ
+      auto partial = InitPartials(scratch, num_chunks, identity);
+      auto chunks = scratch.Allocate<size_t>(num_chunks);
+      std::iota(chunks.begin(), chunks.end(), 0);
+      std::for_each(std::execution::par_unseq, chunks.begin(), chunks.end(), [&](size_t chunk) {
+        const auto [begin, end] = ChunkBounds(size, num_chunks, chunk);
+        partial[chunk] = reduce(begin, end);
+      });
+      return fold(partial);
+#else
+      break;
+#endif
+    }
+    case Backend::kStdThread: {
+      auto partial = InitPartials(scratch, num_chunks, identity);
+      auto reduce_chunks = [&](size_t first_chunk, size_t last_chunk) {
+        for (size_t chunk = first_chunk; chunk < last_chunk; chunk++) {
+          const auto [begin, end] = ChunkBounds(size, num_chunks, chunk);
+          partial[chunk] = reduce(begin, end);
+        }
+      };
+      // std::ref keeps the loop body out of the heap
+      ppc::core::ThreadPool::Global().ParallelFor(0, num_chunks, std::ref(reduce_chunks));
+      return fold(partial);
+    }
+    case Backend::kOmp: {
+#ifdef _OPENMP
+      auto partial = InitPartials(scratch, num_chunks, identity);
+#pragma omp parallel for schedule(static) num_threads(static_cast<int>(num_chunks))
+      for (int chunk = 0; chunk < static_cast<int>(num_chunks); chunk++) {
+        const auto [begin, end] = ChunkBounds(size, num_chunks, static_cast<size_t>(chunk));
+        partial[chunk] = reduce(begin, end);
+      }
+      return fold(partial);
+#else
+      break;
+#endif
+    }
+    case Backend::kTbb: {
+#ifdef USE_TBB
+      return oneapi::tbb::parallel_reduce(
+          oneapi::tbb::blocked_range<size_t>(0, size), identity,
+          [&](const oneapi::tbb::blocked_range<size_t>& range, const Result& result) {
+            return combine(result, reduce(range.begin(), range.end()));
+          },
+          combine);
+#else
+      break;
+#endif
+    }
+    case Backend::kSeq:
+      break;
+  }
+  return combine(identity, reduce(0, size));
+}
+
+// Same as above for code outside of Run(), partial results are allocated on
+// every call
+template <class Result, class Reduce, class Combine>
+Result ChunkedReduce(Backend backend, size_t size, const Result& identity, const Reduce& reduce,
+                     const Combine& combine) {
+  ppc::core::ScratchArena scratch;
+  return ChunkedReduce(backend, scratch, size, identity, reduce, combine);
+}
+
+// Runs body(begin, end) on chunks of [0, size) with given backend
+template <class Body>
+void ChunkedFor(Backend backend, ppc::core::ScratchArena& scratch, size_t size, const Body& body) {
+  ChunkedReduce(
+      backend, scratch, size, true,
+      [&](size_t begin, size_t end) {
+        body(begin, end);
+        return true;
+      },
+      [](bool lhs, bool rhs) { return lhs && rhs; });
+}
+
+template <class Body>
+void ChunkedFor(Backend backend, size_t size, const Body& body) {
+  ppc::core::ScratchArena scratch;
+  ChunkedFor(backend, scratch, size, body);
+}
+
+// Loop for ppc::core::PrepareInput and ppc::util::FirstTouchCopy, chunks are
+// split between threads of the backend like in ChunkedReduce, so copies are
+// first touched on NUMA nodes of threads which reduce them
+inline auto FirstTouchLoop(Backend backend) {
+  return [backend](size_t size, const auto &body) { ChunkedFor(backend, size, body); };
+}
+
+}  // namespace ppc::reference
+
+#endif  // MODULES_REFERENCE_COMMON_REDUCE_HPP_
@@ -5,6 +5,7 @@
 #include <vector>
 
 #include "core/task/include/task.hpp"
+#include "ref/common/include/reduce.hpp"
 #include "ref/max_of_vector_elements/include/ref_task.hpp"
 
 TEST(max_of_vector_elements, check_int32_t) {
@@ -182,3 +183,89 @@ TEST(max_of_vector_elements, check_float) {
   EXPECT_NEAR(out[0], 1.01F, 1e-6F);
   ASSERT_EQ(out_index[0], 0ULL);
 }
+
+TEST(max_of_vector_elements, check_int32_t_view) {
+  // Create data
+  std::vector<int32_t> in(1256, 1);
+  std::vector<int32_t> out(1, 0);
+  std::vector<uint64_t> out_index(1, 0);
+  in[328] = 10;
+
+  // Create task_data
+  auto task_data = std::make_shared<ppc::core::TaskData>();
+  task_data->inputs.emplace_back(reinterpret_cast<uint8_t*>(in.data()));
+  task_data->inputs_count.emplace_back(in.size());
+  task_data->outputs.emplace_back(reinterpret_cast<uint8_t*>(out.data()));
+  task_data->outputs_count.emplace_back(out.size());
+  task_data->outputs.emplace_back(reinterpret_cast<uint8_t*>(out_index.data()));
+  task_data->outputs_count.emplace_back(out_index.size());
+
+  // Create Task
+  ppc::reference::MaxOfVectorElements<int32_t, uint64_t> test_task(task_data, ppc::core::InputMode::kView);
+  bool is_valid = test_task.Validation();
+  ASSERT_EQ(is_valid, true);
+  test_task.PreProcessing();
+  test_task.Run();
+  test_task.PostProcessing();
+  ASSERT_EQ(out[0], 10);
+  ASSERT_EQ(out_index[0], 328ULL);
+}
+
+TEST(max_of_vector_elements, check_int32_t_backends) {
+  for (auto backend : {ppc::reference::Backend::kParUnseq, ppc::reference::Backend::kOmp, ppc::reference::Backend::kTbb,
+                       ppc::reference::Backend::kStdThread}) {
+    SCOPED_TRACE(static_cast<int>(backend));
+    // Create data
+    std::vector<int32_t> in(1256, 1);
+    std::vector<int32_t> out(1, 0);
+    std::vector<uint64_t> out_index(1, 0);
+    // The first of equal extremums is expected
+    in[328] = 10;
+    in[1000] = 10;
+
+    // Create task_data
+    auto task_data = std::make_shared<ppc::core::TaskData>();
+    task_data->inputs.emplace_back(reinterpret_cast<uint8_t*>(in.data()));
+    task_data->inputs_count.emplace_back(in.size());
+    task_data->outputs.emplace_back(reinterpret_cast<uint8_t*>(out.data()));
+    task_data->outputs_count.emplace_back(out.size());
+    task_data->outputs.emplace_back(reinterpret_cast<uint8_t*>(out_index.data()));
+    task_data->outputs_count.emplace_back(out_index.size());
+
+    // Create Task
+    ppc::reference::MaxOfVectorElements<int32_t, uint64_t> test_task(task_data, ppc::core::InputMode::kView, backend);
+    if (!ppc::reference::IsBackendAvailable(backend)) {
+      EXPECT_EQ(test_task.Validation(), false);
+      continue;
+    }
+    bool is_valid = test_task.Validation();
+    ASSERT_EQ(is_valid, true);
+    test_task.PreProcessing();
+    test_task.Run();
+    test_task.PostProcessing();
+    ASSERT_EQ(out[0], 10);
+    ASSERT_EQ(out_index[0], 328ULL);
+  }
+}
+
+TEST(max_of_vector_elements, check_int32_t_typed_buffers) {
+  // Create data
+  std::vector<int32_t> in(1256, 1);
+  in[328] = 10;
+
+  // Create task_data, only typed buffers are set
+  auto task_data = std::make_shared<ppc::core::TaskData>();
+  task_data->input_buffers.emplace_back(ppc::core::Buffer::Borrow(in.data(), in.size()));
+  task_data->output_buffers.emplace_back(ppc::core::Buffer::Allocate<int32_t>(1));
+  task_data->output_buffers.emplace_back(ppc::core::Buffer::Allocate<uint64_t>(1));
+
+  // Create Task
+  ppc::reference::MaxOfVectorElements<int32_t, uint64_t> test_task(task_data);
+  bool is_valid = test_task.Validation();
+  ASSERT_EQ(is_valid, true);
+  test_task.PreProcessing();
+  test_task.Run();
+  test_task.PostProcessing();
+  ASSERT_EQ(task_data->Output<int32_t>(0)[0], 10);
+  ASSERT_EQ(task_data->Output<uint64_t>(1)[0], 328U);
+}
@@ -1,25 +1,28 @@
 #ifndef MODULES_REFERENCE_MAX_OF_VECTOR_ELEMENTS_REF_TASK_HPP_
 #define MODULES_REFERENCE_MAX_OF_VECTOR_ELEMENTS_REF_TASK_HPP_
 
-#include <algorithm>
+#include <functional>
 #include <memory>
+#include <span>
 #include <vector>
 
 #include "core/task/include/task.hpp"
+#include "core/util/include/numa.hpp"
+#include "ref/common/include/extremum.hpp"
+#include "ref/common/include/reduce.hpp"
 
 namespace ppc::reference {
 
 template <class InOutType, class IndexType>
 class MaxOfVectorElements : public ppc::core::Task {
  public:
-  explicit MaxOfVectorElements(ppc::core::TaskDataPtr task_data) : Task(task_data) {}
+  explicit MaxOfVectorElements(ppc::core::TaskDataPtr task_data,
+                               ppc::core::InputMode input_mode = ppc::core::InputMode::kCopy,
+                               Backend backend = Backend::kSeq)
+      : Task(task_data), input_mode_(input_mode), backend_(backend) {}
   bool PreProcessingImpl() override {
     // Init vectors
-    input_ = std::vector<InOutType>(task_data->inputs_count[0]);
-    auto tmp_ptr = reinterpret_cast<InOutType*>(task_data->inputs[0]);
-    for (unsigned i = 0; i < task_data->inputs_count[0]; i++) {
-      input_[i] = tmp_ptr[i];
-    }
+    input_ = ppc::core::PrepareInput(*task_data, 0, input_mode_, input_storage_, FirstTouchLoop(backend_));
     // Init value for output
     max_ = 0.0;
     max_index_ = 0;
@@ -30,27 +33,35 @@ class MaxOfVectorElements : public ppc::core::Task {
     bool is_count_values_correct = false;
     bool is_count_indexes_correct = false;
     // Check count elements of output
-    is_count_values_correct = task_data->outputs_count[0] == 1;
-    is_count_indexes_correct = task_data->outputs_count[1] == 1;
+    if (task_data->NumOutputs() == 2) {
+      is_count_values_correct = task_data->Output<InOutType>(0).size() == 1;
+      is_count_indexes_correct = task_data->Output<IndexType>(1).size() == 1;
+    }
 
-    return is_count_values_correct && is_count_indexes_correct;
+    return is_count_values_correct && is_count_indexes_correct && IsBackendAvailable(backend_);
   }
 
   bool RunImpl() override {
-    auto result = std::max_element(input_.begin(), input_.end());
-    max_ = static_cast<InOutType>(*result);
-    max_index_ = static_cast<IndexType>(std::distance(input_.begin(), result));
+    auto result = FindExtremum(input_, backend_, Scratch(), std::greater<>());
+    if (!result.IsFound()) {
+      return false;
+    }
+    max_ = result.value;
+    max_index_ = static_cast<IndexType>(result.index);
     return true;
   }
 
   bool PostProcessingImpl() override {
-    reinterpret_cast<InOutType*>(task_data->outputs[0])[0] = max_;
-    reinterpret_cast<IndexType*>(task_data->outputs[1])[0] = max_index_;
+    task_data->Output<InOutType>(0)[0] = max_;
+    task_data->Output<IndexType>(1)[0] = max_index_;
     return true;
   }
 
  private:
-  std::vector<InOutType> input_;
+  ppc::core::InputMode input_mode_;
+  Backend backend_;
+  ppc::util::FirstTouchVector<InOutType> input_storage_;
+  std::span<const InOutType> input_;
   InOutType max_;
   IndexType max_index_;
 };
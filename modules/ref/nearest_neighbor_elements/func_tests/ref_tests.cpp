@@ -2,10 +2,14 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <cstdlib>
 #include <memory>
+#include <optional>
+#include <string>
 #include <vector>
 
 #include "core/task/include/task.hpp"
+#include "ref/common/include/reduce.hpp"
 #include "ref/nearest_neighbor_elements/include/ref_task.hpp"
 
 TEST(nearest_neighbor_elements, check_int32_t) {
@@ -203,3 +207,91 @@ TEST(nearest_neighbor_elements, check_float) {
   EXPECT_EQ(out_index[0], 0ULL);
   EXPECT_EQ(out_index[1], 1ULL);
 }
+
+TEST(nearest_neighbor_elements, check_int32_t_view) {
+  // Create data
+  std::vector<int32_t> in(1256, 1);
+  std::vector<int32_t> out(2, 0);
+  std::vector<uint64_t> out_index(2, 0);
+  for (size_t i = 0; i < in.size(); i++) {
+    in[i] = static_cast<int32_t>(2 * i);
+  }
+  in[234] = 0;
+  in[235] = 1;
+
+  // Create task_data
+  auto task_data = std::make_shared<ppc::core::TaskData>();
+  task_data->inputs.emplace_back(reinterpret_cast<uint8_t*>(in.data()));
+  task_data->inputs_count.emplace_back(in.size());
+  task_data->outputs.emplace_back(reinterpret_cast<uint8_t*>(out.data()));
+  task_data->outputs_count.emplace_back(out.size());
+  task_data->outputs.emplace_back(reinterpret_cast<uint8_t*>(out_index.data()));
+  task_data->outputs_count.emplace_back(out_index.size());
+
+  // Create Task
+  ppc::reference::NearestNeighborElements<int32_t, uint64_t> test_task(task_data, ppc::core::InputMode::kView);
+  bool is_valid = test_task.Validation();
+  EXPECT_EQ(is_valid, true);
+  test_task.PreProcessing();
+  test_task.Run();
+  test_task.PostProcessing();
+  EXPECT_EQ(out[0], 0);
+  EXPECT_EQ(out[1], 1);
+  EXPECT_EQ(out_index[0], 234ULL);
+  EXPECT_EQ(out_index[1], 235ULL);
+}
+
+TEST(nearest_neighbor_elements, check_int32_t_backends) {
+#ifndef _WIN32
+  // Split pairs into 4 chunks with every backend
+  const char* env_num_threads = std::getenv("OMP_NUM_THREADS");  // NOLINT(concurrency-mt-unsafe)
+  const std::optional<std::string> save_num_threads =
+      env_num_threads != nullptr ? std::optional<std::string>(env_num_threads) : std::nullopt;
+  setenv("OMP_NUM_THREADS", "4", 1);  // NOLINT(misc-include-cleaner)
+#endif
+  for (auto backend : {ppc::reference::Backend::kStdThread, ppc::reference::Backend::kOmp,
+                       ppc::reference::Backend::kTbb, ppc::reference::Backend::kParUnseq}) {
+    SCOPED_TRACE(static_cast<int>(backend));
+    // Create data, the pair is on the boundary of the first and second chunks
+    std::vector<int32_t> in(1256, 1);
+    std::vector<int32_t> out(2, 0);
+    std::vector<uint64_t> out_index(2, 0);
+    for (size_t i = 0; i < in.size(); i++) {
+      in[i] = static_cast<int32_t>(2 * i);
+    }
+    in[313] = 627;
+
+    // Create task_data
+    auto task_data = std::make_shared<ppc::core::TaskData>();
+    task_data->inputs.emplace_back(reinterpret_cast<uint8_t*>(in.data()));
+    task_data->inputs_count.emplace_back(in.size());
+    task_data->outputs.emplace_back(reinterpret_cast<uint8_t*>(out.data()));
+    task_data->outputs_count.emplace_back(out.size());
+    task_data->outputs.emplace_back(reinterpret_cast<uint8_t*>(out_index.data()));
+    task_data->outputs_count.emplace_back(out_index.size());
+
+    // Create Task
+    ppc::reference::NearestNeighborElements<int32_t, uint64_t> test_task(task_data, ppc::core::InputMode::kView,
+                                                                         backend);
+    if (!ppc::reference::IsBackendAvailable(backend)) {
+      EXPECT_EQ(test_task.Validation(), false);
+      continue;
+    }
+    bool is_valid = test_task.Validation();
+    EXPECT_EQ(is_valid, true);
+    test_task.PreProcessing();
+    test_task.Run();
+    test_task.PostProcessing();
+    EXPECT_EQ(out[0], 627);
+    EXPECT_EQ(out[1], 628);
+    EXPECT_EQ(out_index[0], 313ULL);
+    EXPECT_EQ(out_index[1], 314ULL);
+  }
+#ifndef _WIN32
+  if (save_num_threads) {
+    setenv("OMP_NUM_THREADS", save_num_threads->c_str(), 1);  // NOLINT(misc-include-cleaner)
+  } else {
+    unsetenv("OMP_NUM_THREADS");  // NOLINT(misc-include-cleaner)
+  }
+#endif
+}
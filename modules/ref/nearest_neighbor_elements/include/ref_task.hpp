@@ -1,25 +1,28 @@
 #ifndef MODULES_REFERENCE_NEAREST_NEIGHBOR_ELEMENTS_REF_TASK_HPP_
 #define MODULES_REFERENCE_NEAREST_NEIGHBOR_ELEMENTS_REF_TASK_HPP_
 
-#include <algorithm>
+#include <functional>
 #include <memory>
+#include <span>
 #include <vector>
 
 #include "core/task/include/task.hpp"
+#include "core/util/include/numa.hpp"
+#include "ref/common/include/neighbor_pair.hpp"
+#include "ref/common/include/reduce.hpp"
 
 namespace ppc::reference {
 
 template <class InOutType, class IndexType>
 class NearestNeighborElements : public ppc::core::Task {
  public:
-  explicit NearestNeighborElements(ppc::core::TaskDataPtr task_data) : Task(task_data) {}
+  explicit NearestNeighborElements(ppc::core::TaskDataPtr task_data,
+                                   ppc::core::InputMode input_mode = ppc::core::InputMode::kCopy,
+                                   Backend backend = Backend::kSeq)
+      : Task(task_data), input_mode_(input_mode), backend_(backend) {}
   bool PreProcessingImpl() override {
     // Init vectors
-    input_ = std::vector<InOutType>(task_data->inputs_count[0]);
-    auto tmp_ptr = reinterpret_cast<InOutType*>(task_data->inputs[0]);
-    for (unsigned i = 0; i < task_data->inputs_count[0]; i++) {
-      input_[i] = tmp_ptr[i];
-    }
+    input_ = ppc::core::PrepareInput(*task_data, 0, input_mode_, input_storage_, FirstTouchLoop(backend_));
     // Init value for output
     l_elem_ = r_elem_ = 0;
     l_elem_index_ = r_elem_index_ = 0;
@@ -28,37 +31,38 @@ class NearestNeighborElements : public ppc::core::Task {
 
   bool ValidationImpl() override {
     // Check count elements of output
-    return task_data->outputs_count[0] == 2 && task_data->outputs_count[1] == 2;
+    return task_data->NumOutputs() == 2 && task_data->Output<InOutType>(0).size() == 2 &&
+           task_data->Output<IndexType>(1).size() == 2 && IsBackendAvailable(backend_);
   }
 
   bool RunImpl() override {
-    auto rotate_in = input_;
-    int rot_left = 1;
-    rotate(rotate_in.begin(), rotate_in.begin() + rot_left, rotate_in.end());
-
-    auto temp_res = std::vector<InOutType>(input_.size());
-    std::transform(input_.begin(), input_.end(), rotate_in.begin(), temp_res.begin(),
-                   [](InOutType x, InOutType y) { return std::abs(x - y); });
-
-    auto result = std::min_element(temp_res.begin(), temp_res.end() - 1);
-    l_elem_index_ = static_cast<IndexType>(std::distance(temp_res.begin(), result));
-    l_elem_ = input_[l_elem_index_];
+    auto result = FindNeighborPair(input_, backend_, Scratch(), std::less<>());
+    if (!result.IsFound()) {
+      return false;
+    }
+    l_elem_index_ = static_cast<IndexType>(result.index);
+    l_elem_ = input_[result.index];
 
     r_elem_index_ = l_elem_index_ + 1;
-    r_elem_ = input_[r_elem_index_];
+    r_elem_ = input_[result.index + 1];
     return true;
   }
 
   bool PostProcessingImpl() override {
-    reinterpret_cast<InOutType*>(task_data->outputs[0])[0] = l_elem_;
-    reinterpret_cast<InOutType*>(task_data->outputs[0])[1] = r_elem_;
-    reinterpret_cast<IndexType*>(task_data->outputs[1])[0] = l_elem_index_;
-    reinterpret_cast<IndexType*>(task_data->outputs[1])[1] = r_elem_index_;
+    auto elems = task_data->Output<InOutType>(0);
+    auto indexes = task_data->Output<IndexType>(1);
+    elems[0] = l_elem_;
+    elems[1] = r_elem_;
+    indexes[0] = l_elem_index_;
+    indexes[1] = r_elem_index_;
     return true;
   }
 
  private:
-  std::vector<InOutType> input_;
+  ppc::core::InputMode input_mode_;
+  Backend backend_;
+  ppc::util::FirstTouchVector<InOutType> input_storage_;
+  std::span<const InOutType> input_;
   InOutType l_elem_, r_elem_;
   IndexType l_elem_index_, r_elem_index_;
 };
@@ -1,26 +1,28 @@
 #ifndef MODULES_REFERENCE_NUM_OF_ALTERNATIONS_SIGNS_REF_TASK_HPP_
 #define MODULES_REFERENCE_NUM_OF_ALTERNATIONS_SIGNS_REF_TASK_HPP_
 
-#include <algorithm>
+#include <cstddef>
 #include <functional>
 #include <memory>
+#include <span>
 #include <vector>
 
 #include "core/task/include/task.hpp"
+#include "core/util/include/numa.hpp"
+#include "ref/common/include/reduce.hpp"
 
 namespace ppc::reference {
 
 template <class InOutType, class CountType>
 class NumOfAlternationsSigns : public ppc::core::Task {
  public:
-  explicit NumOfAlternationsSigns(ppc::core::TaskDataPtr task_data) : Task(task_data) {}
+  explicit NumOfAlternationsSigns(ppc::core::TaskDataPtr task_data,
+                                  ppc::core::InputMode input_mode = ppc::core::InputMode::kCopy,
+                                  Backend backend = Backend::kSeq)
+      : Task(task_data), input_mode_(input_mode), backend_(backend) {}
   bool PreProcessingImpl() override {
     // Init vectors
-    input_ = std::vector<InOutType>(task_data->inputs_count[0]);
-    auto tmp_ptr = reinterpret_cast<InOutType*>(task_data->inputs[0]);
-    for (unsigned i = 0; i < task_data->inputs_count[0]; i++) {
-      input_[i] = tmp_ptr[i];
-    }
+    input_ = ppc::core::PrepareInput(*task_data, 0, input_mode_, input_storage_, FirstTouchLoop(backend_));
     // Init value for output
     num_ = 0;
     return true;
@@ -28,28 +30,33 @@ class NumOfAlternationsSigns : public ppc::core::Task {
 
   bool ValidationImpl() override {
     // Check count elements of output
-    return task_data->outputs_count[0] == 1;
+    return task_data->NumOutputs() == 1 && task_data->Output<CountType>(0).size() == 1 && IsBackendAvailable(backend_);
   }
 
   bool RunImpl() override {
-    auto rotate_in = input_;
-    int rot_left = 1;
-    rotate(rotate_in.begin(), rotate_in.begin() + rot_left, rotate_in.end());
-
-    auto temp_res = input_;
-    std::transform(input_.begin(), input_.end(), rotate_in.begin(), temp_res.begin(), std::multiplies<>());
-
-    num_ = std::count_if(temp_res.begin(), temp_res.end() - 1, [](InOutType elem) { return elem < 0; });
+    // Count pairs (i, i + 1) whose product is negative, a chunk reads one element past its end
+    auto reduce = [&](size_t begin, size_t end) {
+      size_t count = 0;
+      for (size_t i = begin; i < end; i++) {
+        count += (input_[i] * input_[i + 1] < 0) ? 1 : 0;
+      }
+      return count;
+    };
+    const auto num_pairs = input_.size() < 2 ? 0 : input_.size() - 1;
+    num_ = static_cast<CountType>(ChunkedReduce(backend_, Scratch(), num_pairs, size_t{0}, reduce, std::plus<>()));
     return true;
   }
 
   bool PostProcessingImpl() override {
-    reinterpret_cast<CountType*>(task_data->outputs[0])[0] = num_;
+    task_data->Output<CountType>(0)[0] = num_;
     return true;
   }
 
  private:
-  std::vector<InOutType> input_;
+  ppc::core::InputMode input_mode_;
+  Backend backend_;
+  ppc::util::FirstTouchVector<InOutType> input_storage_;
+  std::span<const InOutType> input_;
   CountType num_;
 };
 
@@ -6,6 +6,7 @@
 #include <vector>
 
 #include "core/task/include/task.hpp"
+#include "ref/common/include/reduce.hpp"
 #include "ref/num_of_orderly_violations/include/ref_task.hpp"
 
 TEST(num_of_orderly_violations, check_int32_t) {
@@ -145,3 +146,66 @@ TEST(num_of_orderly_violations, check_float) {
   test_task.PostProcessing();
   ASSERT_EQ(out[0], 1ULL);
 }
+
+TEST(num_of_orderly_violations, check_int32_t_view) {
+  // Create data
+  std::vector<int32_t> in(1256, 1);
+  std::vector<uint64_t> out(1, 0);
+  for (size_t i = 0; i < in.size(); i++) {
+    if (i % 2 == 0) {
+      in[i] *= -1;
+    }
+  }
+
+  // Create task_data
+  auto task_data = std::make_shared<ppc::core::TaskData>();
+  task_data->inputs.emplace_back(reinterpret_cast<uint8_t*>(in.data()));
+  task_data->inputs_count.emplace_back(in.size());
+  task_data->outputs.emplace_back(reinterpret_cast<uint8_t*>(out.data()));
+  task_data->outputs_count.emplace_back(out.size());
+
+  // Create Task
+  ppc::reference::NumOfOrderlyViolations<int32_t, uint64_t> test_task(task_data, ppc::core::InputMode::kView);
+  bool is_valid = test_task.Validation();
+  ASSERT_EQ(is_valid, true);
+  test_task.PreProcessing();
+  test_task.Run();
+  test_task.PostProcessing();
+  ASSERT_EQ(out[0], (in.size() / 2) - 1);
+}
+
+TEST(num_of_orderly_violations, check_int32_t_backends) {
+  for (auto backend : {ppc::reference::Backend::kParUnseq, ppc::reference::Backend::kOmp, ppc::reference::Backend::kTbb,
+                       ppc::reference::Backend::kStdThread}) {
+    SCOPED_TRACE(static_cast<int>(backend));
+    // Create data
+    std::vector<int32_t> in(1256, 1);
+    std::vector<uint64_t> out(1, 0);
+    for (size_t i = 0; i < in.size(); i++) {
+      if (i % 2 == 0) {
+        in[i] *= -1;
+      }
+    }
+
+    // Create task_data
+    auto task_data = std::make_shared<ppc::core::TaskData>();
+    task_data->inputs.emplace_back(reinterpret_cast<uint8_t*>(in.data()));
+    task_data->inputs_count.emplace_back(in.size());
+    task_data->outputs.emplace_back(reinterpret_cast<uint8_t*>(out.data()));
+    task_data->outputs_count.emplace_back(out.size());
+
+    // Create Task
+    ppc::reference::NumOfOrderlyViolations<int32_t, uint64_t> test_task(task_data, ppc::core::InputMode::kView,
+                                                                        backend);
+    if (!ppc::reference::IsBackendAvailable(backend)) {
+      EXPECT_EQ(test_task.Validation(), false);
+      continue;
+    }
+    bool is_valid = test_task.Validation();
+    ASSERT_EQ(is_valid, true);
+    test_task.PreProcessing();
+    test_task.Run();
+    test_task.PostProcessing();
+    ASSERT_EQ(out[0], (in.size() / 2) - 1);
+  }
+}
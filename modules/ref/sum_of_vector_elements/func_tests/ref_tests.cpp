@@ -4,7 +4,9 @@
 #include <memory>
 #include <vector>
 
+#include "core/perf/include/perf.hpp"
 #include "core/task/include/task.hpp"
+#include "ref/common/include/reduce.hpp"
 #include "ref/sum_of_vector_elements/include/ref_task.hpp"
 
 TEST(sum_of_vector_elements, check_int32_t) {
@@ -122,3 +124,84 @@ TEST(sum_of_vector_elements, check_float) {
   test_task.PostProcessing();
   EXPECT_NEAR(out[0], static_cast<float>(in.size()), 1e-3F);
 }
+
+TEST(sum_of_vector_elements, check_int32_t_view) {
+  // Create data
+  std::vector<int32_t> in(1256, 1);
+  std::vector<int32_t> out(1, 0);
+  // Create task_data
+  auto task_data = std::make_shared<ppc::core::TaskData>();
+  task_data->inputs.emplace_back(reinterpret_cast<uint8_t*>(in.data()));
+  task_data->inputs_count.emplace_back(in.size());
+  task_data->outputs.emplace_back(reinterpret_cast<uint8_t*>(out.data()));
+  task_data->outputs_count.emplace_back(out.size());
+  // Create Task
+  ppc::reference::SumOfVectorElements<int32_t> test_task(task_data, ppc::core::InputMode::kView);
+  bool is_valid = test_task.Validation();
+  ASSERT_EQ(is_valid, true);
+  test_task.PreProcessing();
+  test_task.Run();
+  test_task.PostProcessing();
+  ASSERT_EQ(static_cast<uint64_t>(out[0]), in.size());
+}
+
+TEST(sum_of_vector_elements, check_int32_t_backends) {
+  for (auto backend : {ppc::reference::Backend::kParUnseq, ppc::reference::Backend::kOmp, ppc::reference::Backend::kTbb,
+                       ppc::reference::Backend::kStdThread}) {
+    SCOPED_TRACE(static_cast<int>(backend));
+    // Create data
+    std::vector<int32_t> in(1256, 1);
+    std::vector<int32_t> out(1, 0);
+    // Create task_data
+    auto task_data = std::make_shared<ppc::core::TaskData>();
+    task_data->inputs.emplace_back(reinterpret_cast<uint8_t*>(in.data()));
+    task_data->inputs_count.emplace_back(in.size());
+    task_data->outputs.emplace_back(reinterpret_cast<uint8_t*>(out.data()));
+    task_data->outputs_count.emplace_back(out.size());
+    // Create Task
+    ppc::reference::SumOfVectorElements<int32_t> test_task(task_data, ppc::core::InputMode::kView, backend);
+    if (!ppc::reference::IsBackendAvailable(backend)) {
+      EXPECT_EQ(test_task.Validation(), false);
+      continue;
+    }
+    bool is_valid = test_task.Validation();
+    ASSERT_EQ(is_valid, true);
+    test_task.PreProcessing();
+    test_task.Run();
+    test_task.PostProcessing();
+    ASSERT_EQ(static_cast<uint64_t>(out[0]), in.size());
+  }
+}
+
+TEST(sum_of_vector_elements, check_run_does_not_allocate) {
+  // TBB and parallel algorithms allocate tasks with their own allocators
+  for (auto backend : {ppc::reference::Backend::kSeq, ppc::reference::Backend::kOmp,
+                       ppc::reference::Backend::kStdThread}) {
+    if (!ppc::reference::IsBackendAvailable(backend)) {
+      continue;
+    }
+    SCOPED_TRACE(static_cast<int>(backend));
+    // Create data
+    std::vector<int32_t> in(1256, 1);
+    std::vector<int32_t> out(1, 0);
+    // Create task_data
+    auto task_data = std::make_shared<ppc::core::TaskData>();
+    task_data->inputs.emplace_back(reinterpret_cast<uint8_t*>(in.data()));
+    task_data->inputs_count.emplace_back(in.size());
+    task_data->outputs.emplace_back(reinterpret_cast<uint8_t*>(out.data()));
+    task_data->outputs_count.emplace_back(out.size());
+    // Create Task
+    auto test_task = std::make_shared<ppc::reference::SumOfVectorElements<int32_t>>(
+        task_data, ppc::core::InputMode::kView, backend);
+
+    // The warmup grows the scratch arena and starts threads of the backend
+    auto perf_attr = std::make_shared<ppc::core::PerfAttr>();
+    perf_attr->num_running = 5;
+    perf_attr->num_warmup = 1;
+    perf_attr->forbid_run_allocations = true;
+    auto perf_results = std::make_shared<ppc::core::PerfResults>();
+    ppc::core::Perf perf_analyzer(test_task);
+    ASSERT_NO_THROW(perf_analyzer.TaskRun(perf_attr, perf_results));
+    ASSERT_EQ(static_cast<uint64_t>(out[0]), in.size());
+  }
+}
@@ -1,24 +1,28 @@
 #pragma once
 
+#include <cstddef>
+#include <functional>
 #include <memory>
 #include <numeric>
+#include <span>
 #include <vector>
 
 #include "core/task/include/task.hpp"
+#include "core/util/include/numa.hpp"
+#include "ref/common/include/reduce.hpp"
 
 namespace ppc::reference {
 
 template <class InOutType>
 class SumOfVectorElements : public ppc::core::Task {
  public:
-  explicit SumOfVectorElements(ppc::core::TaskDataPtr task_data) : Task(task_data) {}
+  explicit SumOfVectorElements(ppc::core::TaskDataPtr task_data,
+                               ppc::core::InputMode input_mode = ppc::core::InputMode::kCopy,
+                               Backend backend = Backend::kSeq)
+      : Task(task_data), input_mode_(input_mode), backend_(backend) {}
   bool PreProcessingImpl() override {
     // Init vectors
-    input_ = std::vector<InOutType>(task_data->inputs_count[0]);
-    auto tmp_ptr = reinterpret_cast<InOutType*>(task_data->inputs[0]);
-    for (unsigned i = 0; i < task_data->inputs_count[0]; i++) {
-      input_[i] = tmp_ptr[i];
-    }
+    input_ = ppc::core::PrepareInput(*task_data, 0, input_mode_, input_storage_, FirstTouchLoop(backend_));
     // Init value for output
     sum_ = 0;
     return true;
@@ -26,21 +30,28 @@ class SumOfVectorElements : public ppc::core::Task {
 
   bool ValidationImpl() override {
     // Check count elements of output
-    return task_data->outputs_count[0] == 1;
+    return task_data->NumOutputs() == 1 && task_data->Output<InOutType>(0).size() == 1 && IsBackendAvailable(backend_);
   }
 
   bool RunImpl() override {
-    sum_ = std::accumulate(input_.begin(), input_.end(), 0);
+    auto reduce = [&](size_t begin, size_t end) {
+      auto chunk = input_.subspan(begin, end - begin);
+      return std::accumulate(chunk.begin(), chunk.end(), InOutType{});
+    };
+    sum_ = ChunkedReduce(backend_, Scratch(), input_.size(), InOutType{}, reduce, std::plus<>());
     return true;
   }
 
   bool PostProcessingImpl() override {
-    reinterpret_cast<InOutType*>(task_data->outputs[0])[0] = sum_;
+    task_data->Output<InOutType>(0)[0] = sum_;
     return true;
   }
 
  private:
-  std::vector<InOutType> input_;
+  ppc::core::InputMode input_mode_;
+  Backend backend_;
+  ppc::util::FirstTouchVector<InOutType> input_storage_;
+  std::span<const InOutType> input_;
   InOutType sum_;
 };
 
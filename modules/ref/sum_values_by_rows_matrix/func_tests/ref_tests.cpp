@@ -6,6 +6,7 @@
 #include <vector>
 
 #include "core/task/include/task.hpp"
+#include "ref/common/include/reduce.hpp"
 #include "ref/sum_values_by_rows_matrix/include/ref_task.hpp"
 
 TEST(sum_values_by_rows_matrix, check_int32_t) {
@@ -194,3 +195,103 @@ TEST(sum_values_by_rows_matrix, check_float) {
     EXPECT_NEAR(out[i], in_index[1] * (in_index[1] + 1) * (2 * in_index[1] + 1) / 6.F, 1e-6);
   }
 }
+
+TEST(sum_values_by_rows_matrix, check_int32_t_view) {
+  // Create data
+  std::vector<int32_t> in(1369, 2);
+  std::vector<uint64_t> in_index(2, 37);
+  std::vector<int32_t> out(37, 0);
+
+  // Create task_data
+  auto task_data = std::make_shared<ppc::core::TaskData>();
+  task_data->inputs.emplace_back(reinterpret_cast<uint8_t*>(in.data()));
+  task_data->inputs_count.emplace_back(in.size());
+  task_data->inputs.emplace_back(reinterpret_cast<uint8_t*>(in_index.data()));
+  task_data->inputs_count.emplace_back(in_index.size());
+  task_data->outputs.emplace_back(reinterpret_cast<uint8_t*>(out.data()));
+  task_data->outputs_count.emplace_back(out.size());
+
+  // Create Task
+  ppc::reference::SumValuesByRowsMatrix<int32_t, uint64_t> test_task(task_data, ppc::core::InputMode::kView);
+  bool is_valid = test_task.Validation();
+  ASSERT_EQ(is_valid, true);
+  test_task.PreProcessing();
+  test_task.Run();
+  test_task.PostProcessing();
+  for (size_t i = 0; i < in_index[0]; i++) {
+    ASSERT_EQ(static_cast<uint64_t>(out[0]), 2 * in_index[0]);
+  }
+}
+
+TEST(sum_values_by_rows_matrix, check_int32_t_backends) {
+  for (auto backend : {ppc::reference::Backend::kParUnseq, ppc::reference::Backend::kOmp, ppc::reference::Backend::kTbb,
+                       ppc::reference::Backend::kStdThread}) {
+    SCOPED_TRACE(static_cast<int>(backend));
+    // Create data
+    std::vector<int32_t> in(1369, 2);
+    std::vector<uint64_t> in_index(2, 37);
+    std::vector<int32_t> out(37, 0);
+
+    // Create task_data
+    auto task_data = std::make_shared<ppc::core::TaskData>();
+    task_data->inputs.emplace_back(reinterpret_cast<uint8_t*>(in.data()));
+    task_data->inputs_count.emplace_back(in.size());
+    task_data->inputs.emplace_back(reinterpret_cast<uint8_t*>(in_index.data()));
+    task_data->inputs_count.emplace_back(in_index.size());
+    task_data->outputs.emplace_back(reinterpret_cast<uint8_t*>(out.data()));
+    task_data->outputs_count.emplace_back(out.size());
+
+    // Create Task
+    ppc::reference::SumValuesByRowsMatrix<int32_t, uint64_t> test_task(task_data, ppc::core::InputMode::kView, backend);
+    if (!ppc::reference::IsBackendAvailable(backend)) {
+      EXPECT_EQ(test_task.Validation(), false);
+      continue;
+    }
+    bool is_valid = test_task.Validation();
+    ASSERT_EQ(is_valid, true);
+    test_task.PreProcessing();
+    test_task.Run();
+    test_task.PostProcessing();
+    for (size_t i = 0; i < in_index[0]; i++) {
+      ASSERT_EQ(static_cast<uint64_t>(out[i]), 2 * in_index[0]);
+    }
+  }
+}
+
+TEST(sum_values_by_rows_matrix, check_int32_t_typed_buffers) {
+  // Create data
+  std::vector<int32_t> in(1369, 2);
+  std::vector<uint64_t> in_index(2, 37);
+
+  // Create task_data, only typed buffers are set
+  auto task_data = std::make_shared<ppc::core::TaskData>();
+  task_data->input_buffers.emplace_back(ppc::core::Buffer::Borrow(in.data(), in.size()));
+  task_data->input_buffers.emplace_back(ppc::core::Buffer::Borrow(in_index.data(), in_index.size()));
+  task_data->output_buffers.emplace_back(ppc::core::Buffer::Allocate<int32_t>(in_index[0]));
+
+  // Create Task
+  ppc::reference::SumValuesByRowsMatrix<int32_t, uint64_t> test_task(task_data);
+  bool is_valid = test_task.Validation();
+  ASSERT_EQ(is_valid, true);
+  test_task.PreProcessing();
+  test_task.Run();
+  test_task.PostProcessing();
+  for (auto sum : task_data->Output<int32_t>(0)) {
+    ASSERT_EQ(static_cast<uint64_t>(sum), 2 * in_index[1]);
+  }
+}
+
+TEST(sum_values_by_rows_matrix, check_validate_typed_buffers) {
+  // Create data
+  std::vector<int32_t> in(1369, 2);
+  std::vector<uint64_t> in_index(2, 37);
+
+  // Create task_data, only typed buffers are set
+  auto task_data = std::make_shared<ppc::core::TaskData>();
+  task_data->input_buffers.emplace_back(ppc::core::Buffer::Borrow(in.data(), in.size()));
+  task_data->input_buffers.emplace_back(ppc::core::Buffer::Borrow(in_index.data(), in_index.size()));
+
+  // Create Task
+  ppc::reference::SumValuesByRowsMatrix<int32_t, uint64_t> test_task(task_data);
+  ASSERT_EQ(test_task.Validation(), false);
+}
@@ -4,53 +4,66 @@
 #include <cstddef>
 #include <memory>
 #include <numeric>
+#include <span>
 #include <vector>
 
 #include "core/task/include/task.hpp"
+#include "core/util/include/numa.hpp"
+#include "ref/common/include/reduce.hpp"
 
 namespace ppc::reference {
 
 template <class InOutType, class IndexType>
 class SumValuesByRowsMatrix : public ppc::core::Task {
  public:
-  explicit SumValuesByRowsMatrix(ppc::core::TaskDataPtr task_data) : Task(task_data) {}
+  explicit SumValuesByRowsMatrix(ppc::core::TaskDataPtr task_data,
+                                 ppc::core::InputMode input_mode = ppc::core::InputMode::kCopy,
+                                 Backend backend = Backend::kSeq)
+      : Task(task_data), input_mode_(input_mode), backend_(backend) {}
   bool PreProcessingImpl() override {
     // Init vectors
-    input_ = std::vector<InOutType>(task_data->inputs_count[0]);
-    auto tmp_ptr = reinterpret_cast<InOutType*>(task_data->inputs[0]);
-    for (unsigned i = 0; i < task_data->inputs_count[0]; i++) {
-      input_[i] = tmp_ptr[i];
-    }
-    rows_ = reinterpret_cast<IndexType*>(task_data->inputs[1])[0];
-    cols_ = reinterpret_cast<IndexType*>(task_data->inputs[1])[1];
+    input_ = ppc::core::PrepareInput(*task_data, 0, input_mode_, input_storage_, FirstTouchLoop(backend_));
+    const auto shape = task_data->Input<IndexType>(1);
+    rows_ = shape[0];
+    cols_ = shape[1];
 
     // Init value for output
-    sum_ = std::vector<InOutType>(cols_, 0.F);
+    sum_ = std::vector<InOutType>(rows_, 0.F);
     return true;
   }
 
   bool ValidationImpl() override {
     // Check count elements of output
-    return static_cast<bool>(task_data->inputs_count[1] == 2 &&
-                             task_data->outputs_count[0] == reinterpret_cast<IndexType*>(task_data->inputs[1])[0]);
+    return task_data->NumInputs() == 2 && task_data->Input<IndexType>(1).size() == 2 &&
+           task_data->NumOutputs() == 1 &&
+           task_data->Output<InOutType>(0).size() == static_cast<size_t>(task_data->Input<IndexType>(1)[0]) &&
+           IsBackendAvailable(backend_);
   }
 
   bool RunImpl() override {
-    for (size_t i = 0; i < rows_; i++) {
-      sum_[i] = std::accumulate(input_.begin() + (cols_ * i), input_.begin() + (cols_ * (i + 1)), 0.F);
-    }
+    // Rows are independent, so every chunk of rows is summed on its own
+    ChunkedFor(backend_, Scratch(), rows_, [&](size_t begin, size_t end) {
+      for (size_t i = begin; i < end; i++) {
+        auto row = input_.subspan(cols_ * i, cols_);
+        sum_[i] = std::accumulate(row.begin(), row.end(), 0.F);
+      }
+    });
     return true;
   }
 
   bool PostProcessingImpl() override {
+    auto output = task_data->Output<InOutType>(0);
     for (IndexType i = 0; i < rows_; i++) {
-      reinterpret_cast<InOutType*>(task_data->outputs[0])[i] = sum_[i];
+      output[i] = sum_[i];
     }
     return true;
   }
 
  private:
-  std::vector<InOutType> input_;
+  ppc::core::InputMode input_mode_;
+  Backend backend_;
+  ppc::util::FirstTouchVector<InOutType> input_storage_;
+  std::span<const InOutType> input_;
   IndexType rows_, cols_;
   std::vector<InOutType> sum_;
 };
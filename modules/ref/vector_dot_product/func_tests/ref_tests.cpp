@@ -6,6 +6,7 @@
 #include <vector>
 
 #include "core/task/include/task.hpp"
+#include "ref/common/include/reduce.hpp"
 #include "ref/vector_dot_product/include/ref_task.hpp"
 
 TEST(vector_dot_product, check_int32_t) {
@@ -187,3 +188,71 @@ TEST(vector_dot_product, check_float) {
   test_task.PostProcessing();
   EXPECT_NEAR(out[0], in1.size() * (-1.3F) * 1.2F, 1e-3F);
 }
+
+TEST(vector_dot_product, check_int32_t_view) {
+  // Create data
+  const uint64_t count_data = 1256;
+  std::vector<int32_t> in1(count_data, 1);
+  std::vector<int32_t> in2(count_data, 1);
+  std::vector<int32_t> out(1, 0);
+  for (size_t i = 0; i < count_data; i++) {
+    in1[i] = static_cast<int32_t>(i + 1);
+    in2[i] = static_cast<int32_t>(i + 1);
+  }
+
+  // Create task_data
+  auto task_data = std::make_shared<ppc::core::TaskData>();
+  task_data->inputs.emplace_back(reinterpret_cast<uint8_t*>(in1.data()));
+  task_data->inputs_count.emplace_back(in1.size());
+  task_data->inputs.emplace_back(reinterpret_cast<uint8_t*>(in2.data()));
+  task_data->inputs_count.emplace_back(in2.size());
+  task_data->outputs.emplace_back(reinterpret_cast<uint8_t*>(out.data()));
+  task_data->outputs_count.emplace_back(out.size());
+
+  // Create Task
+  ppc::reference::VectorDotProduct<int32_t> test_task(task_data, ppc::core::InputMode::kView);
+  bool is_valid = test_task.Validation();
+  ASSERT_EQ(is_valid, true);
+  test_task.PreProcessing();
+  test_task.Run();
+  test_task.PostProcessing();
+  ASSERT_EQ(static_cast<uint64_t>(out[0]), (count_data * (count_data + 1) * (2 * count_data + 1)) / 6);
+}
+
+TEST(vector_dot_product, check_int32_t_backends) {
+  for (auto backend : {ppc::reference::Backend::kParUnseq, ppc::reference::Backend::kOmp, ppc::reference::Backend::kTbb,
+                       ppc::reference::Backend::kStdThread}) {
+    SCOPED_TRACE(static_cast<int>(backend));
+    // Create data
+    const uint64_t count_data = 1256;
+    std::vector<int32_t> in1(count_data, 1);
+    std::vector<int32_t> in2(count_data, 1);
+    std::vector<int32_t> out(1, 0);
+    for (size_t i = 0; i < count_data; i++) {
+      in1[i] = static_cast<int32_t>(i + 1);
+      in2[i] = static_cast<int32_t>(i + 1);
+    }
+
+    // Create task_data
+    auto task_data = std::make_shared<ppc::core::TaskData>();
+    task_data->inputs.emplace_back(reinterpret_cast<uint8_t*>(in1.data()));
+    task_data->inputs_count.emplace_back(in1.size());
+    task_data->inputs.emplace_back(reinterpret_cast<uint8_t*>(in2.data()));
+    task_data->inputs_count.emplace_back(in2.size());
+    task_data->outputs.emplace_back(reinterpret_cast<uint8_t*>(out.data()));
+    task_data->outputs_count.emplace_back(out.size());
+
+    // Create Task
+    ppc::reference::VectorDotProduct<int32_t> test_task(task_data, ppc::core::InputMode::kView, backend);
+    if (!ppc::reference::IsBackendAvailable(backend)) {
+      EXPECT_EQ(test_task.Validation(), false);
+      continue;
+    }
+    bool is_valid = test_task.Validation();
+    ASSERT_EQ(is_valid, true);
+    test_task.PreProcessing();
+    test_task.Run();
+    test_task.PostProcessing();
+    ASSERT_EQ(static_cast<uint64_t>(out[0]), (count_data * (count_data + 1) * (2 * count_data + 1)) / 6);
+  }
+}
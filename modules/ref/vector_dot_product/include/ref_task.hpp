@@ -1,28 +1,31 @@
 #ifndef MODULES_REFERENCE_VECTOR_DOT_PRODUCT_REF_TASK_HPP_
 #define MODULES_REFERENCE_VECTOR_DOT_PRODUCT_REF_TASK_HPP_
 
+#include <array>
 #include <cstddef>
+#include <functional>
 #include <memory>
 #include <numeric>
+#include <span>
 #include <vector>
 
 #include "core/task/include/task.hpp"
+#include "core/util/include/numa.hpp"
+#include "ref/common/include/reduce.hpp"
 
 namespace ppc::reference {
 
 template <class InOutType>
 class VectorDotProduct : public ppc::core::Task {
  public:
-  explicit VectorDotProduct(ppc::core::TaskDataPtr task_data) : Task(task_data) {}
+  explicit VectorDotProduct(ppc::core::TaskDataPtr task_data,
+                            ppc::core::InputMode input_mode = ppc::core::InputMode::kCopy,
+                            Backend backend = Backend::kSeq)
+      : Task(task_data), input_mode_(input_mode), backend_(backend) {}
   bool PreProcessingImpl() override {
     // Init vectors
-    input_ = std::vector<std::vector<InOutType> >(2);
     for (size_t i = 0; i < input_.size(); i++) {
-      input_[i] = std::vector<InOutType>(task_data->inputs_count[i]);
-      auto tmp_ptr = reinterpret_cast<InOutType*>(task_data->inputs[i]);
-      for (unsigned j = 0; j < task_data->inputs_count[i]; j++) {
-        input_[i][j] = tmp_ptr[j];
-      }
+      input_[i] = ppc::core::PrepareInput(*task_data, i, input_mode_, input_storage_[i], FirstTouchLoop(backend_));
     }
 
     // Init value for output
@@ -32,21 +35,32 @@ class VectorDotProduct : public ppc::core::Task {
 
   bool ValidationImpl() override {
     // Check count elements of output
-    return task_data->outputs_count[0] == 1 && task_data->inputs_count[0] == task_data->inputs_count[1];
+    return task_data->NumInputs() == 2 &&
+           task_data->Input<InOutType>(0).size() == task_data->Input<InOutType>(1).size() &&
+           task_data->NumOutputs() == 1 && task_data->Output<InOutType>(0).size() == 1 && IsBackendAvailable(backend_);
   }
 
   bool RunImpl() override {
-    dor_product_ = std::inner_product(input_[0].begin(), input_[0].end(), input_[1].begin(), 0.0);
+    auto reduce = [&](size_t begin, size_t end) {
+      auto lhs = input_[0].subspan(begin, end - begin);
+      auto rhs = input_[1].subspan(begin, end - begin);
+      return std::inner_product(lhs.begin(), lhs.end(), rhs.begin(), 0.0);
+    };
+    dor_product_ =
+        static_cast<InOutType>(ChunkedReduce(backend_, Scratch(), input_[0].size(), 0.0, reduce, std::plus<>()));
     return true;
   }
 
   bool PostProcessingImpl() override {
-    reinterpret_cast<InOutType*>(task_data->outputs[0])[0] = dor_product_;
+    task_data->Output<InOutType>(0)[0] = dor_product_;
     return true;
   }
 
  private:
-  std::vector<std::vector<InOutType> > input_;
+  ppc::core::InputMode input_mode_;
+  Backend backend_;
+  std::array<ppc::util::FirstTouchVector<InOutType>, 2> input_storage_;
+  std::array<std::span<const InOutType>, 2> input_;
   InOutType dor_product_;
 };
 
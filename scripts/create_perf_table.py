@@ -1,12 +1,18 @@
 import argparse
+import csv
+import json
 import os
 import re
 import xlsxwriter
 import multiprocessing
 
 parser = argparse.ArgumentParser()
-parser.add_argument('-i', '--input', help='Input file path (logs of perf tests, .txt)', required=True)
+parser.add_argument('-i', '--input', required=True,
+                    help='Input file path (logs of perf tests, .txt, or their results, .jsonl/.csv)')
 parser.add_argument('-o', '--output', help='Output file path (path to .xlsx table)', required=True)
+parser.add_argument('--scaling', action='store_true',
+                    help='Build speedup/efficiency curves from results of scaling sweeps '
+                         '(run_tests.py --running-type=performance-scaling)')
 args = parser.parse_args()
 logs_path = os.path.abspath(args.input)
 xlsx_path = os.path.abspath(args.output)
@@ -16,32 +22,118 @@ list_of_type_of_tasks = ["all", "mpi", "omp", "seq", "stl", "tbb"]
 result_tables = {"pipeline": {}, "task_run": {}}
 set_of_task_name = []
 
-logs_file = open(logs_path, "r")
-logs_lines = logs_file.readlines()
-for line in logs_lines:
-    pattern = r'tasks[\/|\\](\w*)[\/|\\](\w*):(\w*):(-*\d*\.\d*)'
-    result = re.findall(pattern, line)
-    if len(result):
-        task_name = result[0][1]
-        perf_type = result[0][2]
-        set_of_task_name.append(task_name)
-        result_tables[perf_type][task_name] = {}
-
-        for ttype in list_of_type_of_tasks:
-            result_tables[perf_type][task_name][ttype] = -1.0
-
-for line in logs_lines:
-    pattern = r'tasks[\/|\\](\w*)[\/|\\](\w*):(\w*):(-*\d*\.\d*)'
-    result = re.findall(pattern, line)
-    if len(result):
-        task_type = result[0][0]
-        task_name = result[0][1]
-        perf_type = result[0][2]
-        perf_time = float(result[0][3])
-        if perf_time < 1.0:
-            msg = f"Performance time = {perf_time} < 1 second : for {task_type} - {task_name} - {perf_type} \n"
-            raise Exception(msg)
-        result_tables[perf_type][task_name][task_type] = perf_time
+
+def add_result(task_type, task_name, perf_type, perf_time):
+    if perf_type not in result_tables:
+        return
+    set_of_task_name.append(task_name)
+    if task_name not in result_tables[perf_type]:
+        result_tables[perf_type][task_name] = {ttype: -1.0 for ttype in list_of_type_of_tasks}
+    if perf_time < 1.0:
+        msg = f"Performance time = {perf_time} < 1 second : for {task_type} - {task_name} - {perf_type} \n"
+        raise Exception(msg)
+    result_tables[perf_type][task_name][task_type] = perf_time
+
+
+def load_records(path):
+    # Records written by perf tests to PPC_PERF_RESULTS (.jsonl or .csv)
+    if path.endswith(".csv"):
+        with open(path, newline="") as results_file:
+            return list(csv.DictReader(results_file))
+    with open(path, "r") as results_file:
+        return [json.loads(line) for line in results_file if line.strip()]
+
+
+def largest_problems(records, get_key):
+    # Tests benchmarked over several sizes write a record per size, the table
+    # shows the largest one
+    largest = {}
+    for record in records:
+        key = get_key(record)
+        if key not in largest or int(record.get("problem_size", 0)) > int(largest[key].get("problem_size", 0)):
+            largest[key] = record
+    return list(largest.values())
+
+
+def read_structured_results(path):
+    records = [record for record in load_records(path) if record["path"].replace("\\", "/").startswith("tasks/")]
+    for record in largest_problems(records, lambda r: (r["backend"], r["task"], r["type_of_running"])):
+        add_result(record["backend"], record["task"], record["type_of_running"], float(record["time_sec"]))
+
+
+def read_logs(path):
+    with open(path, "r") as logs_file:
+        for line in logs_file.readlines():
+            pattern = r'tasks[\/|\\](\w*)[\/|\\](\w*):(\w*):(-*\d*\.\d*)'
+            result = re.findall(pattern, line)
+            if len(result):
+                add_result(result[0][0], result[0][1], result[0][2], float(result[0][3]))
+
+
+def write_scaling_tables(path):
+    # T(p) of every task and backend, where p = threads * processes. Strong
+    # scaling: S(p) = T(1) / T(p); weak scaling (work grows p times): Eff(p) =
+    # T(1) / T(p) and S(p) is the scaled speedup p * Eff(p)
+    curves = {"pipeline": {}, "task_run": {}}
+    weak = False
+    records = largest_problems(load_records(path), lambda r: (r["task"], r["backend"], r["type_of_running"],
+                                                              int(r["num_threads"]) * int(r["num_processes"])))
+    for record in records:
+        if record["type_of_running"] not in curves or not record["path"].replace("\\", "/").startswith("tasks/"):
+            continue
+        parallelism = int(record["num_threads"]) * int(record["num_processes"])
+        weak = weak or float(record.get("work_scale", 1.0)) != 1.0
+        curve = curves[record["type_of_running"]].setdefault((record["task"], record["backend"]), {})
+        curve[parallelism] = float(record["time_sec"])
+
+    for table_name, table_curves in curves.items():
+        workbook = xlsxwriter.Workbook(os.path.join(xlsx_path, table_name + '_scaling_table.xlsx'))
+        worksheet = workbook.add_worksheet()
+        worksheet.set_column('A:F', 18)
+        bold = workbook.add_format({'bold': True, 'bottom': 2})
+        for column, title in enumerate(["task", "backend", "p", "T(p)", "S(p)", "Eff(p)"]):
+            worksheet.write(0, column, title + (" (weak)" if weak and title != "task" else ""), bold)
+
+        chart = workbook.add_chart({'type': 'scatter', 'subtype': 'straight_with_markers'})
+        num_series = 0
+        row = 1
+        for (task_name, backend), curve in sorted(table_curves.items()):
+            if 1 not in curve:
+                print(f"Warning! Scaling curve of '{task_name}' ({backend}) has no point for 1 thread/process")
+                continue
+            if len(curve) < 2:
+                continue
+            first_row = row
+            for parallelism in sorted(curve):
+                time = curve[parallelism]
+                efficiency = curve[1] / time if weak else curve[1] / time / parallelism
+                worksheet.write_row(row, 0, [task_name, backend, parallelism, time, efficiency * parallelism,
+                                             efficiency])
+                row += 1
+            chart.add_series({
+                'name': f"{task_name} ({backend})",
+                'categories': [worksheet.name, first_row, 2, row - 1, 2],
+                'values': [worksheet.name, first_row, 4, row - 1, 4],
+            })
+            num_series += 1
+        if num_series == 0:
+            workbook.close()
+            continue
+        chart.set_title({'name': f"{'Scaled speedup' if weak else 'Speedup'} ({table_name})"})
+        chart.set_x_axis({'name': 'threads / processes'})
+        chart.set_y_axis({'name': 'S(p)'})
+        worksheet.insert_chart('H2', chart)
+        workbook.close()
+
+
+if args.scaling:
+    write_scaling_tables(logs_path)
+    raise SystemExit(0)
+
+if logs_path.endswith((".jsonl", ".csv")):
+    read_structured_results(logs_path)
+else:
+    read_logs(logs_path)
 
 
 for table_name in result_tables:
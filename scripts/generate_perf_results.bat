@@ -1,4 +1,7 @@
 @echo off
 mkdir build\perf_stat_dir
+del /q build\perf_stat_dir\perf_results.jsonl 2>nul
+set PPC_PERF_RESULTS=%cd%\build\perf_stat_dir\perf_results.jsonl
 python3 scripts/run_tests.py --running-type="performance" > build\perf_stat_dir\perf_log.txt
-python scripts\create_perf_table.py --input build\perf_stat_dir\perf_log.txt --output build\perf_stat_dir
+python scripts\create_perf_table.py --input build\perf_stat_dir\perf_results.jsonl --output build\perf_stat_dir
+python scripts\perf_regression.py compare --input build\perf_stat_dir\perf_results.jsonl
@@ -0,0 +1,7 @@
+# Usage: generate_scaling_results.sh [strong|weak]
+SCALING="${1:-strong}"
+mkdir -p build/perf_stat_dir
+rm -f "build/perf_stat_dir/scaling_${SCALING}.jsonl"
+export PPC_PERF_RESULTS="$(pwd)/build/perf_stat_dir/scaling_${SCALING}.jsonl"
+python3 scripts/run_tests.py --running-type="performance-scaling" --scaling="${SCALING}" | tee "build/perf_stat_dir/scaling_${SCALING}_log.txt"
+python3 scripts/create_perf_table.py --scaling --input "build/perf_stat_dir/scaling_${SCALING}.jsonl" --output build/perf_stat_dir
@@ -0,0 +1,180 @@
+import csv
+import json
+import math
+import statistics
+import sys
+from pathlib import Path
+
+import yaml
+
+
+def init_cmd_args():
+    import argparse
+    parser = argparse.ArgumentParser(
+        description="Baseline of perf results and the regression check against it. Results are records written "
+                    "by perf tests to PPC_PERF_RESULTS (.jsonl or .csv)."
+    )
+    parser.add_argument(
+        "command",
+        choices=["update", "compare"],
+        help="'update' stores results as the baseline, 'compare' fails if results are significantly slower."
+    )
+    parser.add_argument("-i", "--input", required=True, help="Perf results (.jsonl or .csv).")
+    parser.add_argument(
+        "--baseline",
+        required=False,
+        default=str(get_project_path() / "scoreboard" / "data" / "performance.yml"),
+        help="Baseline store (default: scoreboard/data/performance.yml)."
+    )
+    parser.add_argument(
+        "--alpha",
+        required=False,
+        type=float,
+        default=0.01,
+        help="Significance level of the one-sided Mann-Whitney U test."
+    )
+    parser.add_argument(
+        "--min-slowdown",
+        required=False,
+        type=float,
+        default=0.05,
+        help="Relative growth of the median which is reported, smaller significant changes are ignored."
+    )
+    args = parser.parse_args()
+    _args_dict = vars(args)
+    return _args_dict
+
+
+def get_project_path():
+    script_path = Path(__file__).resolve()
+    script_dir = script_path.parent
+    return script_dir.parent
+
+
+def load_records(path):
+    if str(path).endswith(".csv"):
+        with open(path, newline="") as results_file:
+            records = list(csv.DictReader(results_file))
+        for record in records:
+            record["samples_sec"] = [float(sample) for sample in record["samples_sec"].split()]
+        return records
+    with open(path, "r") as results_file:
+        return [json.loads(line) for line in results_file if line.strip()]
+
+
+def get_key(record):
+    # task / backend / type of running / <processes>x<threads>[_n<problem size>]
+    workers = f"{int(record['num_processes'])}x{int(record['num_threads'])}"
+    if int(record.get("problem_size", 0)) > 0:
+        workers += f"_n{int(record['problem_size'])}"
+    return record["task"], record["backend"], record["type_of_running"], workers
+
+
+def load_baseline(path):
+    if not Path(path).exists():
+        return {}
+    with open(path, "r") as baseline_file:
+        data = yaml.safe_load(baseline_file) or {}
+    return data.get("performance") or {}
+
+
+def median_absolute_deviation(samples):
+    median = statistics.median(samples)
+    return statistics.median(abs(sample - median) for sample in samples)
+
+
+def mann_whitney_greater(current, baseline):
+    # One-sided p-value of H1: samples of current are stochastically greater than
+    # samples of baseline. Normal approximation of U with the tie correction.
+    n1, n2 = len(current), len(baseline)
+    values = sorted([(value, 0) for value in current] + [(value, 1) for value in baseline])
+    ranks = [0.0] * len(values)
+    tie_sum = 0.0
+    i = 0
+    while i < len(values):
+        j = i
+        while j + 1 < len(values) and values[j + 1][0] == values[i][0]:
+            j += 1
+        for k in range(i, j + 1):
+            ranks[k] = (i + j) / 2.0 + 1.0
+        ties = j - i + 1
+        tie_sum += ties ** 3 - ties
+        i = j + 1
+
+    rank_sum = sum(rank for rank, (_, group) in zip(ranks, values) if group == 0)
+    u = rank_sum - n1 * (n1 + 1) / 2.0
+    n = n1 + n2
+    variance = n1 * n2 / 12.0 * ((n + 1) - tie_sum / (n * (n - 1)))
+    if variance <= 0.0:
+        return 1.0
+    # Continuity correction towards the mean
+    z = (u - n1 * n2 / 2.0 - 0.5) / math.sqrt(variance)
+    return 0.5 * math.erfc(z / math.sqrt(2.0))
+
+
+def update_baseline(records, path):
+    baseline = load_baseline(path)
+    for record in records:
+        if float(record.get("work_scale", 1.0)) != 1.0:
+            continue
+        task, backend, type_of_running, workers = get_key(record)
+        samples = [float(sample) for sample in record["samples_sec"]]
+        if not samples:
+            continue
+        baseline.setdefault(task, {}).setdefault(backend, {}).setdefault(type_of_running, {})[workers] = {
+            "median_sec": statistics.median(samples),
+            "mad_sec": median_absolute_deviation(samples),
+            "samples_sec": samples,
+            "host": record.get("host", ""),
+            "git_revision": record.get("git_revision", ""),
+        }
+    # Leading comments of the store describe its format, they are kept
+    header = []
+    if Path(path).exists():
+        with open(path, "r") as baseline_file:
+            header = [line for line in baseline_file.readlines() if line.startswith("#")]
+    with open(path, "w") as baseline_file:
+        baseline_file.writelines(header)
+        yaml.safe_dump({"performance": baseline}, baseline_file, sort_keys=True)
+    print(f"Baseline is stored to {path}")
+
+
+def compare_with_baseline(records, path, alpha, min_slowdown):
+    baseline = load_baseline(path)
+    regressions = []
+    for record in records:
+        if float(record.get("work_scale", 1.0)) != 1.0:
+            continue
+        key = get_key(record)
+        task, backend, type_of_running, workers = key
+        reference = baseline.get(task, {}).get(backend, {}).get(type_of_running, {}).get(workers)
+        name = "/".join(key)
+        samples = [float(sample) for sample in record["samples_sec"]]
+        if reference is None or not samples:
+            print(f"{name}: no baseline")
+            continue
+
+        median = statistics.median(samples)
+        slowdown = median / reference["median_sec"] - 1.0 if reference["median_sec"] > 0.0 else 0.0
+        p_value = mann_whitney_greater(samples, reference["samples_sec"])
+        is_regression = p_value < alpha and slowdown > min_slowdown
+        status = "REGRESSION" if is_regression else "ok"
+        print(f"{name}: median {median:.6f} s vs {reference['median_sec']:.6f} s ({slowdown:+.1%}), "
+              f"p = {p_value:.4g}: {status}")
+        if is_regression:
+            regressions.append(name)
+
+    if regressions:
+        print(f"Performance regressions ({len(regressions)}): {', '.join(regressions)}")
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    args_dict = init_cmd_args()
+    perf_records = load_records(args_dict["input"])
+    if args_dict["command"] == "update":
+        update_baseline(perf_records, args_dict["baseline"])
+    else:
+        sys.exit(compare_with_baseline(perf_records, args_dict["baseline"], args_dict["alpha"],
+                                       args_dict["min_slowdown"]))
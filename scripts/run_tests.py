@@ -10,9 +10,24 @@ def init_cmd_args():
     parser.add_argument(
         "--running-type",
         required=True,
-        choices=["threads", "processes", "performance", "performance-list"],
+        choices=["threads", "processes", "performance", "performance-list", "performance-scaling"],
         help="Specify the execution mode. Choose 'threads' for multithreading or 'processes' for multiprocessing."
     )
+    parser.add_argument(
+        "--scaling",
+        required=False,
+        default="strong",
+        choices=["strong", "weak"],
+        help="Scaling of 'performance-scaling' runs: 'strong' keeps sizes of perf tests, "
+             "'weak' grows their work with the number of threads/processes."
+    )
+    parser.add_argument(
+        "--max-parallelism",
+        required=False,
+        type=int,
+        default=os.cpu_count(),
+        help="The last step of the ladder of threads/processes of 'performance-scaling' runs (default: CPU count)."
+    )
     parser.add_argument(
         "--additional-mpi-args",
         required=False,
@@ -140,6 +155,42 @@ class PPCRunner:
         self.__run_exec(f"{self.work_dir / 'stl_perf_tests'} {self.__get_gtest_settings(1)}")
         self.__run_exec(f"{self.work_dir / 'tbb_perf_tests'} {self.__get_gtest_settings(1)}")
 
+    @staticmethod
+    def __get_ladder(max_parallelism):
+        # 1, 2, 4, ... and max_parallelism itself
+        ladder = [1]
+        while ladder[-1] * 2 <= max_parallelism:
+            ladder.append(ladder[-1] * 2)
+        if ladder[-1] != max_parallelism:
+            ladder.append(max_parallelism)
+        return ladder
+
+    def run_performance_scaling(self, scaling, max_parallelism, additional_mpi_args):
+        # Records of every step are appended to PPC_PERF_RESULTS, they contain
+        # numbers of threads/processes and the work scale of the step
+        if not os.environ.get("PPC_PERF_RESULTS"):
+            raise EnvironmentError("Required environment variable 'PPC_PERF_RESULTS' is not set.")
+
+        saved_env = dict(os.environ)
+        try:
+            for parallelism in self.__get_ladder(max(max_parallelism, 1)):
+                os.environ["PPC_WORK_SCALE"] = str(parallelism) if scaling == "weak" else "1"
+
+                os.environ["OMP_NUM_THREADS"] = "1"
+                if parallelism == 1:
+                    self.__run_exec(f"{self.work_dir / 'seq_perf_tests'} {self.__get_gtest_settings(1)}")
+                if not os.environ.get("ASAN_RUN"):
+                    mpi_running = f"{self.mpi_exec} {additional_mpi_args} -np {parallelism}"
+                    self.__run_exec(f"{mpi_running} {self.work_dir / 'all_perf_tests'} {self.__get_gtest_settings(1)}")
+                    self.__run_exec(f"{mpi_running} {self.work_dir / 'mpi_perf_tests'} {self.__get_gtest_settings(1)}")
+
+                os.environ["OMP_NUM_THREADS"] = str(parallelism)
+                for task_type in ["omp", "stl", "tbb"]:
+                    self.__run_exec(f"{self.work_dir / f'{task_type}_perf_tests'} {self.__get_gtest_settings(1)}")
+        finally:
+            os.environ.clear()
+            os.environ.update(saved_env)
+
     def run_performance_list(self):
         for task_type in ["all", "mpi", "omp", "seq", "stl", "tbb"]:
             self.__run_exec(f"{self.work_dir / f'{task_type}_perf_tests'} --gtest_list_tests")
@@ -160,6 +211,9 @@ if __name__ == "__main__":
         ppc_runner.run_processes(args_dict["additional_mpi_args"])
     elif args_dict["running_type"] == "performance":
         ppc_runner.run_performance()
+    elif args_dict["running_type"] == "performance-scaling":
+        ppc_runner.run_performance_scaling(args_dict["scaling"], args_dict["max_parallelism"],
+                                           args_dict["additional_mpi_args"])
     elif args_dict["running_type"] == "performance-list":
         ppc_runner.run_performance_list()
     else:
@@ -1,5 +1,6 @@
 #include <gtest/gtest.h>
 
+#include <boost/mpi/communicator.hpp>
 #include <cstddef>
 #include <cstdint>
 #include <memory>
@@ -34,7 +35,10 @@ TEST(nesterov_a_test_task_all, test_matmul_50) {
   test_task_all.PreProcessing();
   test_task_all.Run();
   test_task_all.PostProcessing();
-  EXPECT_EQ(in, out);
+  boost::mpi::communicator world;
+  if (world.rank() == 0) {
+    EXPECT_EQ(in, out);
+  }
 }
 
 TEST(nesterov_a_test_task_all, test_matmul_from_pic) {
@@ -63,5 +67,55 @@ TEST(nesterov_a_test_task_all, test_matmul_from_pic) {
   test_task_all.PreProcessing();
   test_task_all.Run();
   test_task_all.PostProcessing();
-  EXPECT_EQ(in, out);
+  boost::mpi::communicator world;
+  if (world.rank() == 0) {
+    EXPECT_EQ(in, out);
+  }
+}
+
+TEST(nesterov_a_test_task_all, test_matmul_hybrid_engines) {
+  constexpr size_t kCount = 75;
+
+  // Create data
+  std::vector<int> in(kCount * kCount, 0);
+  std::vector<int> expected(kCount * kCount, 0);
+  for (size_t i = 0; i < in.size(); i++) {
+    in[i] = static_cast<int>((i * 7) % 11) - 5;
+  }
+  for (size_t i = 0; i < kCount; i++) {
+    for (size_t j = 0; j < kCount; j++) {
+      for (size_t k = 0; k < kCount; k++) {
+        expected[(i * kCount) + j] += in[(i * kCount) + k] * in[(k * kCount) + j];
+      }
+    }
+  }
+
+  boost::mpi::communicator world;
+  for (auto backend : {nesterov_a_test_task_all::ThreadBackend::kOmp, nesterov_a_test_task_all::ThreadBackend::kTbb,
+                       nesterov_a_test_task_all::ThreadBackend::kStdThread}) {
+    for (bool overlap : {false, true}) {
+      std::vector<int> out(kCount * kCount, 0);
+
+      // Create task_data, only the root process needs data
+      auto task_data_all = std::make_shared<ppc::core::TaskData>();
+      if (world.rank() == 0) {
+        task_data_all->inputs.emplace_back(reinterpret_cast<uint8_t *>(in.data()));
+        task_data_all->inputs_count.emplace_back(in.size());
+        task_data_all->outputs.emplace_back(reinterpret_cast<uint8_t *>(out.data()));
+        task_data_all->outputs_count.emplace_back(out.size());
+      }
+
+      // Create Task
+      nesterov_a_test_task_all::TestTaskALL test_task_all(task_data_all, backend, overlap);
+      ASSERT_EQ(test_task_all.Validation(), true);
+      test_task_all.PreProcessing();
+      test_task_all.Run();
+      test_task_all.Run();
+      test_task_all.PostProcessing();
+
+      if (world.rank() == 0) {
+        EXPECT_EQ(expected, out) << "backend = " << static_cast<int>(backend) << ", overlap = " << overlap;
+      }
+    }
+  }
 }
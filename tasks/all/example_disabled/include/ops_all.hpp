@@ -2,25 +2,50 @@
 
 #include <boost/mpi/collectives.hpp>
 #include <boost/mpi/communicator.hpp>
+#include <cstdint>
+#include <memory>
 #include <utility>
 #include <vector>
 
 #include "core/task/include/task.hpp"
+#include "oneapi/tbb/task_arena.h"
 
 namespace nesterov_a_test_task_all {
 
+// Scheduler of row tiles between threads of one process
+enum class ThreadBackend : uint8_t { kOmp, kTbb, kStdThread };
+
+// Hybrid matrix multiplication: rows of the left matrix are split between MPI
+// processes, the right matrix is broadcast and every process splits its rows
+// into tiles for its threads. With overlap enabled the rows of a process are
+// computed in stages and every finished stage is sent to rank 0 while the next
+// one is computed, otherwise blocks are gathered after the computation. Only
+// rank 0 needs task data
 class TestTaskALL : public ppc::core::Task {
  public:
-  explicit TestTaskALL(ppc::core::TaskDataPtr task_data) : Task(std::move(task_data)) {}
+  explicit TestTaskALL(ppc::core::TaskDataPtr task_data, ThreadBackend backend = ThreadBackend::kOmp,
+                       bool overlap = false)
+      : Task(std::move(task_data)), backend_(backend), overlap_(overlap) {}
   bool PreProcessingImpl() override;
   bool ValidationImpl() override;
   bool RunImpl() override;
   bool PostProcessingImpl() override;
 
  private:
+  // Computes rows [row_begin, row_end) of the local block with the thread backend
+  void ComputeRows(const int *right_matrix, int row_begin, int row_end, int *local_output);
+  void RunGathered(const int *right_matrix);
+  void RunOverlapped(const int *right_matrix);
+
+  ThreadBackend backend_;
+  bool overlap_;
   std::vector<int> input_, output_;
   int rc_size_{};
+  int num_threads_{};
+  std::vector<int> block_sizes_, block_displs_;
+  std::vector<int> local_input_, local_output_, right_matrix_;
+  std::unique_ptr<oneapi::tbb::task_arena> arena_;
   boost::mpi::communicator world_;
 };
 
-}  // namespace nesterov_a_test_task_all
\ No newline at end of file
+}  // namespace nesterov_a_test_task_all
@@ -1,103 +1,30 @@
 #include <gtest/gtest.h>
 
-#include <chrono>
 #include <cstddef>
-#include <cstdint>
-#include <memory>
 #include <vector>
 
 #include "all/example/include/ops_all.hpp"
 #include "boost/mpi/communicator.hpp"
-#include "core/perf/include/perf.hpp"
-#include "core/task/include/task.hpp"
-
-TEST(nesterov_a_test_task_all, test_pipeline_run) {
-  constexpr int kCount = 400;
-
-  // Create data
-  std::vector<int> in(kCount * kCount, 0);
-  std::vector<int> out(kCount * kCount, 0);
-
-  for (size_t i = 0; i < kCount; i++) {
-    in[(i * kCount) + i] = 1;
-  }
-
-  // Create task_data
-  auto task_data_all = std::make_shared<ppc::core::TaskData>();
-  task_data_all->inputs.emplace_back(reinterpret_cast<uint8_t *>(in.data()));
-  task_data_all->inputs_count.emplace_back(in.size());
-  task_data_all->outputs.emplace_back(reinterpret_cast<uint8_t *>(out.data()));
-  task_data_all->outputs_count.emplace_back(out.size());
-
-  // Create Task
-  auto test_task_all = std::make_shared<nesterov_a_test_task_all::TestTaskALL>(task_data_all);
-
-  // Create Perf attributes
-  auto perf_attr = std::make_shared<ppc::core::PerfAttr>();
-  perf_attr->num_running = 10;
-  const auto t0 = std::chrono::high_resolution_clock::now();
-  perf_attr->current_timer = [&] {
-    auto current_time_point = std::chrono::high_resolution_clock::now();
-    auto duration = std::chrono::duration_cast<std::chrono::nanoseconds>(current_time_point - t0).count();
-    return static_cast<double>(duration) * 1e-9;
+#include "core/perf/include/perf_test.hpp"
+
+namespace {
+
+ppc::core::PerfTestCase<nesterov_a_test_task_all::TestTaskALL, int> MakeTestCase() {
+  ppc::core::PerfTestCase<nesterov_a_test_task_all::TestTaskALL, int> test_case;
+  test_case.sizes = {400};
+  test_case.work_exponent = 3.0;
+  test_case.generate = [](size_t count) {
+    std::vector<int> in(count * count, 0);
+    for (size_t i = 0; i < count; i++) {
+      in[(i * count) + i] = 1;
+    }
+    return in;
   };
-
-  // Create and init perf results
-  auto perf_results = std::make_shared<ppc::core::PerfResults>();
-
-  auto perf_analyzer = std::make_shared<ppc::core::Perf>(test_task_all);
-  perf_analyzer->PipelineRun(perf_attr, perf_results);
-  // Create Perf analyzer
-  boost::mpi::communicator world;
-  if (world.rank() == 0) {
-    ppc::core::Perf::PrintPerfStatistic(perf_results);
-  }
-
-  ASSERT_EQ(in, out);
+  test_case.check = [](const std::vector<int> &in, const std::vector<int> &out) { return in == out; };
+  test_case.is_root = [] { return boost::mpi::communicator().rank() == 0; };
+  return test_case;
 }
 
-TEST(nesterov_a_test_task_all, test_task_run) {
-  constexpr int kCount = 400;
+}  // namespace
 
-  // Create data
-  std::vector<int> in(kCount * kCount, 0);
-  std::vector<int> out(kCount * kCount, 0);
-
-  for (size_t i = 0; i < kCount; i++) {
-    in[(i * kCount) + i] = 1;
-  }
-
-  // Create task_data
-  auto task_data_all = std::make_shared<ppc::core::TaskData>();
-  task_data_all->inputs.emplace_back(reinterpret_cast<uint8_t *>(in.data()));
-  task_data_all->inputs_count.emplace_back(in.size());
-  task_data_all->outputs.emplace_back(reinterpret_cast<uint8_t *>(out.data()));
-  task_data_all->outputs_count.emplace_back(out.size());
-
-  // Create Task
-  auto test_task_all = std::make_shared<nesterov_a_test_task_all::TestTaskALL>(task_data_all);
-
-  // Create Perf attributes
-  auto perf_attr = std::make_shared<ppc::core::PerfAttr>();
-  perf_attr->num_running = 10;
-  const auto t0 = std::chrono::high_resolution_clock::now();
-  perf_attr->current_timer = [&] {
-    auto current_time_point = std::chrono::high_resolution_clock::now();
-    auto duration = std::chrono::duration_cast<std::chrono::nanoseconds>(current_time_point - t0).count();
-    return static_cast<double>(duration) * 1e-9;
-  };
-
-  // Create and init perf results
-  auto perf_results = std::make_shared<ppc::core::PerfResults>();
-
-  // Create Perf analyzer
-  auto perf_analyzer = std::make_shared<ppc::core::Perf>(test_task_all);
-  perf_analyzer->TaskRun(perf_attr, perf_results);
-  // Create Perf analyzer
-  boost::mpi::communicator world;
-  if (world.rank() == 0) {
-    ppc::core::Perf::PrintPerfStatistic(perf_results);
-  }
-
-  ASSERT_EQ(in, out);
-}
+PPC_PERF_TESTS(nesterov_a_test_task_all, MakeTestCase)
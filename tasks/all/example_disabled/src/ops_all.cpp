@@ -1,78 +1,201 @@
 #include "all/example/include/ops_all.hpp"
 
+#include <omp.h>
+
+#include <algorithm>
+#include <boost/mpi/collectives/broadcast.hpp>
+#include <boost/mpi/collectives/gatherv.hpp>
+#include <boost/mpi/collectives/scatterv.hpp>
+#include <boost/mpi/nonblocking.hpp>
+#include <boost/mpi/request.hpp>
 #include <cmath>
 #include <cstddef>
-#include <functional>
-#include <thread>
+#include <memory>
+#include <utility>
 #include <vector>
 
+#include "core/thread_pool/include/thread_pool.hpp"
 #include "core/util/include/util.hpp"
+#include "oneapi/tbb/blocked_range.h"
+#include "oneapi/tbb/parallel_for.h"
 #include "oneapi/tbb/task_arena.h"
-#include "oneapi/tbb/task_group.h"
 
 namespace {
-void MatMul(const std::vector<int> &in_vec, int rc_size, std::vector<int> &out_vec) {
-  for (int i = 0; i < rc_size; ++i) {
-    for (int j = 0; j < rc_size; ++j) {
-      out_vec[(i * rc_size) + j] = 0;
-      for (int k = 0; k < rc_size; ++k) {
-        out_vec[(i * rc_size) + j] += in_vec[(i * rc_size) + k] * in_vec[(k * rc_size) + j];
+
+// Number of rows in a tile of work of one thread
+constexpr int kRowsPerTile = 8;
+
+// Maximum number of stages of rows of one process in the overlapped mode
+constexpr int kNumStages = 4;
+
+// out[rows] = a[rows] * b, the i-k-j order walks rows of both matrices
+// contiguously, so the inner loop is vectorized
+void MatMulRows(const int *a, const int *b, int rc_size, int row_begin, int row_end, int *out) {
+  for (int i = row_begin; i < row_end; ++i) {
+    int *out_row = out + (static_cast<ptrdiff_t>(i) * rc_size);
+    std::fill(out_row, out_row + rc_size, 0);
+    for (int k = 0; k < rc_size; ++k) {
+      const int a_ik = a[(static_cast<ptrdiff_t>(i) * rc_size) + k];
+      const int *b_row = b + (static_cast<ptrdiff_t>(k) * rc_size);
+      for (int j = 0; j < rc_size; ++j) {
+        out_row[j] += a_ik * b_row[j];
       }
     }
   }
 }
+
+// Bounds of the part with given number when [0, size) is split into num_parts
+std::pair<int, int> PartBounds(int size, int num_parts, int part) {
+  const int begin = (part * (size / num_parts)) + std::min(part, size % num_parts);
+  return {begin, begin + (size / num_parts) + (part < size % num_parts ? 1 : 0)};
+}
+
 }  // namespace
 
 bool nesterov_a_test_task_all::TestTaskALL::PreProcessingImpl() {
   // Init value for input and output
-  unsigned int input_size = task_data->inputs_count[0];
-  auto *in_ptr = reinterpret_cast<int *>(task_data->inputs[0]);
-  input_ = std::vector<int>(in_ptr, in_ptr + input_size);
+  if (world_.rank() == 0) {
+    const auto input = task_data->Input<int>(0);
+    input_.assign(input.begin(), input.end());
+
+    const size_t output_size = task_data->Output<int>(0).size();
+    output_ = std::vector<int>(output_size, 0);
+
+    rc_size_ = static_cast<int>(std::sqrt(input.size()));
+  }
+  boost::mpi::broadcast(world_, rc_size_, 0);
 
-  unsigned int output_size = task_data->outputs_count[0];
-  output_ = std::vector<int>(output_size, 0);
+  // Split rows between processes into almost equal contiguous blocks
+  const int num_procs = world_.size();
+  block_sizes_.assign(num_procs, 0);
+  block_displs_.assign(num_procs, 0);
+  for (int proc = 0; proc < num_procs; proc++) {
+    const auto [row_begin, row_end] = PartBounds(rc_size_, num_procs, proc);
+    block_sizes_[proc] = (row_end - row_begin) * rc_size_;
+    block_displs_[proc] = row_begin * rc_size_;
+  }
 
-  rc_size_ = static_cast<int>(std::sqrt(input_size));
+  // Buffers and threads are set up once, so runs only communicate and compute
+  const int local_size = block_sizes_[world_.rank()];
+  local_input_.assign(local_size, 0);
+  local_output_.assign(local_size, 0);
+  if (world_.rank() != 0) {
+    right_matrix_.assign(static_cast<size_t>(rc_size_) * rc_size_, 0);
+  }
+  num_threads_ = std::max(ppc::util::GetPPCNumThreads(), 1);
+  if (backend_ == ThreadBackend::kTbb && (!arena_ || arena_->max_concurrency() != num_threads_)) {
+    arena_ = std::make_unique<oneapi::tbb::task_arena>(num_threads_);
+    arena_->initialize();
+  }
   return true;
 }
 
 bool nesterov_a_test_task_all::TestTaskALL::ValidationImpl() {
-  // Check equality of counts elements
-  return task_data->inputs_count[0] == task_data->outputs_count[0];
+  // Check equality of counts elements on the root, all ranks get the same answer
+  bool is_valid = true;
+  if (world_.rank() == 0) {
+    is_valid = task_data->Input<int>(0).size() == task_data->Output<int>(0).size();
+  }
+  boost::mpi::broadcast(world_, is_valid, 0);
+  return is_valid;
 }
 
-bool nesterov_a_test_task_all::TestTaskALL::RunImpl() {
-  if (world_.rank() == 0) {
-#pragma omp parallel default(none)
-    {
-#pragma omp critical
-      { MatMul(input_, rc_size_, output_); }
+void nesterov_a_test_task_all::TestTaskALL::ComputeRows(const int *right_matrix, int row_begin, int row_end,
+                                                        int *local_output) {
+  const int num_tiles = (row_end - row_begin + kRowsPerTile - 1) / kRowsPerTile;
+  auto compute_tile = [&](int tile) {
+    const int tile_begin = row_begin + (tile * kRowsPerTile);
+    MatMulRows(local_input_.data(), right_matrix, rc_size_, tile_begin, std::min(tile_begin + kRowsPerTile, row_end),
+               local_output);
+  };
+
+  switch (backend_) {
+    case ThreadBackend::kOmp:
+#pragma omp parallel for schedule(static) num_threads(num_threads_)
+      for (int tile = 0; tile < num_tiles; ++tile) {
+        compute_tile(tile);
+      }
+      break;
+    case ThreadBackend::kTbb:
+      arena_->execute([&] {
+        oneapi::tbb::parallel_for(oneapi::tbb::blocked_range<int>(0, num_tiles), [&](const auto &range) {
+          for (int tile = range.begin(); tile < range.end(); ++tile) {
+            compute_tile(tile);
+          }
+        });
+      });
+      break;
+    case ThreadBackend::kStdThread: {
+      auto compute_tiles = [&](size_t tile_begin, size_t tile_end) {
+        for (auto tile = tile_begin; tile < tile_end; tile++) {
+          compute_tile(static_cast<int>(tile));
+        }
+      };
+      ppc::core::ThreadPool::Global().ParallelFor(0, static_cast<size_t>(num_tiles), compute_tiles);
+      break;
     }
+  }
+}
+
+void nesterov_a_test_task_all::TestTaskALL::RunGathered(const int *right_matrix) {
+  const int local_size = block_sizes_[world_.rank()];
+  ComputeRows(right_matrix, 0, local_size / std::max(rc_size_, 1), local_output_.data());
+  if (world_.rank() == 0) {
+    boost::mpi::gatherv(world_, local_output_.data(), local_size, output_.data(), block_sizes_, block_displs_, 0);
   } else {
-    oneapi::tbb::task_arena arena(1);
-    arena.execute([&] {
-      tbb::task_group tg;
-      for (int i = 0; i < ppc::util::GetPPCNumThreads(); ++i) {
-        tg.run([&] { MatMul(input_, rc_size_, output_); });
+    boost::mpi::gatherv(world_, local_output_.data(), local_size, 0);
+  }
+}
+
+void nesterov_a_test_task_all::TestTaskALL::RunOverlapped(const int *right_matrix) {
+  // Stage s of a process carries its rows PartBounds(rows, stages, s), rank 0
+  // knows the layout of every process and receives stages right into the output
+  auto num_stages = [&](int proc) { return std::min(kNumStages, block_sizes_[proc] / std::max(rc_size_, 1)); };
+  std::vector<boost::mpi::request> requests;
+  if (world_.rank() == 0) {
+    for (int proc = 1; proc < world_.size(); proc++) {
+      const int num_rows = block_sizes_[proc] / std::max(rc_size_, 1);
+      for (int stage = 0; stage < num_stages(proc); stage++) {
+        const auto [row_begin, row_end] = PartBounds(num_rows, num_stages(proc), stage);
+        requests.push_back(world_.irecv(proc, stage, output_.data() + block_displs_[proc] + (row_begin * rc_size_),
+                                        (row_end - row_begin) * rc_size_));
       }
-      tg.wait();
-    });
+    }
+    ComputeRows(right_matrix, 0, block_sizes_[0] / std::max(rc_size_, 1), output_.data());
+  } else {
+    const int num_rows = block_sizes_[world_.rank()] / std::max(rc_size_, 1);
+    for (int stage = 0; stage < num_stages(world_.rank()); stage++) {
+      const auto [row_begin, row_end] = PartBounds(num_rows, num_stages(world_.rank()), stage);
+      ComputeRows(right_matrix, row_begin, row_end, local_output_.data());
+      requests.push_back(world_.isend(0, stage, local_output_.data() + (row_begin * rc_size_),
+                                      (row_end - row_begin) * rc_size_));
+    }
   }
+  boost::mpi::wait_all(requests.begin(), requests.end());
+}
 
-  const int num_threads = ppc::util::GetPPCNumThreads();
-  std::vector<std::thread> threads(num_threads);
-  for (int i = 0; i < num_threads; i++) {
-    threads[i] = std::thread(MatMul, std::cref(input_), rc_size_, std::ref(output_));
-    threads[i].join();
+bool nesterov_a_test_task_all::TestTaskALL::RunImpl() {
+  const int local_size = block_sizes_[world_.rank()];
+  int *right_matrix = world_.rank() == 0 ? input_.data() : right_matrix_.data();
+
+  if (world_.rank() == 0) {
+    boost::mpi::scatterv(world_, input_.data(), block_sizes_, block_displs_, local_input_.data(), local_size, 0);
+  } else {
+    boost::mpi::scatterv(world_, local_input_.data(), local_size, 0);
   }
+  boost::mpi::broadcast(world_, right_matrix, rc_size_ * rc_size_, 0);
 
-  world_.barrier();
+  if (overlap_) {
+    RunOverlapped(right_matrix);
+  } else {
+    RunGathered(right_matrix);
+  }
   return true;
 }
 
 bool nesterov_a_test_task_all::TestTaskALL::PostProcessingImpl() {
-  for (size_t i = 0; i < output_.size(); i++) {
-    reinterpret_cast<int *>(task_data->outputs[0])[i] = output_[i];
+  if (world_.rank() == 0) {
+    std::ranges::copy(output_, task_data->Output<int>(0).begin());
   }
   return true;
 }
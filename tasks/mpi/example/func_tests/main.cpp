@@ -1,5 +1,6 @@
 #include <gtest/gtest.h>
 
+#include <boost/mpi/communicator.hpp>
 #include <cstddef>
 #include <cstdint>
 #include <fstream>
@@ -36,7 +37,10 @@ TEST(nesterov_a_test_task_mpi, test_matmul_50) {
   test_task_mpi.Run();
   test_task_mpi.PostProcessing();
 
-  EXPECT_EQ(in, out);
+  boost::mpi::communicator world;
+  if (world.rank() == 0) {
+    EXPECT_EQ(in, out);
+  }
 }
 
 TEST(nesterov_a_test_task_mpi, test_matmul_100_from_file) {
@@ -71,5 +75,49 @@ TEST(nesterov_a_test_task_mpi, test_matmul_100_from_file) {
   test_task_mpi.Run();
   test_task_mpi.PostProcessing();
 
-  EXPECT_EQ(in, out);
+  boost::mpi::communicator world;
+  if (world.rank() == 0) {
+    EXPECT_EQ(in, out);
+  }
+}
+
+TEST(nesterov_a_test_task_mpi, test_matmul_row_blocks) {
+  // Sizes cover fewer rows than processes and uneven blocks
+  for (size_t count : {1, 3, 37, 128}) {
+    // Create data
+    std::vector<int> in(count * count, 0);
+    std::vector<int> out(count * count, 0);
+    std::vector<int> expected(count * count, 0);
+    for (size_t i = 0; i < in.size(); i++) {
+      in[i] = static_cast<int>((i * 7) % 11) - 5;
+    }
+    for (size_t i = 0; i < count; i++) {
+      for (size_t j = 0; j < count; j++) {
+        for (size_t k = 0; k < count; k++) {
+          expected[(i * count) + j] += in[(i * count) + k] * in[(k * count) + j];
+        }
+      }
+    }
+
+    // Create task_data, only the root process needs data
+    boost::mpi::communicator world;
+    auto task_data_mpi = std::make_shared<ppc::core::TaskData>();
+    if (world.rank() == 0) {
+      task_data_mpi->inputs.emplace_back(reinterpret_cast<uint8_t *>(in.data()));
+      task_data_mpi->inputs_count.emplace_back(in.size());
+      task_data_mpi->outputs.emplace_back(reinterpret_cast<uint8_t *>(out.data()));
+      task_data_mpi->outputs_count.emplace_back(out.size());
+    }
+
+    // Create Task
+    nesterov_a_test_task_mpi::TestTaskMPI test_task_mpi(task_data_mpi);
+    ASSERT_EQ(test_task_mpi.Validation(), true);
+    test_task_mpi.PreProcessing();
+    test_task_mpi.Run();
+    test_task_mpi.PostProcessing();
+
+    if (world.rank() == 0) {
+      EXPECT_EQ(expected, out) << "count = " << count;
+    }
+  }
 }
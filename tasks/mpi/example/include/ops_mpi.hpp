@@ -9,6 +9,9 @@
 
 namespace nesterov_a_test_task_mpi {
 
+// Rows of the left matrix are scattered from rank 0 in contiguous blocks, the
+// right matrix is broadcast, every rank multiplies its block and blocks of the
+// result are gathered back on rank 0. Only rank 0 needs task data
 class TestTaskMPI : public ppc::core::Task {
  public:
   explicit TestTaskMPI(ppc::core::TaskDataPtr task_data) : Task(std::move(task_data)) {}
@@ -20,7 +23,9 @@ class TestTaskMPI : public ppc::core::Task {
  private:
   std::vector<int> input_, output_;
   int rc_size_{};
+  std::vector<int> block_sizes_, block_displs_;
+  std::vector<int> local_input_, local_output_, right_matrix_;
   boost::mpi::communicator world_;
 };
 
-}  // namespace nesterov_a_test_task_mpi
\ No newline at end of file
+}  // namespace nesterov_a_test_task_mpi
@@ -1,54 +1,101 @@
 #include "mpi/example/include/ops_mpi.hpp"
 
+#include <algorithm>
+#include <boost/mpi/collectives/broadcast.hpp>
+#include <boost/mpi/collectives/gatherv.hpp>
+#include <boost/mpi/collectives/scatterv.hpp>
 #include <cmath>
 #include <cstddef>
 #include <vector>
 
+namespace {
+
+// out[rows] = a[rows] * b for a block of rows of a, the i-k-j order walks rows
+// of both matrices contiguously, so the inner loop is vectorized
+void MatMulRows(const std::vector<int> &a, const int *b, int rc_size, int num_rows, std::vector<int> &out) {
+  for (int i = 0; i < num_rows; ++i) {
+    int *out_row = out.data() + (static_cast<ptrdiff_t>(i) * rc_size);
+    std::fill(out_row, out_row + rc_size, 0);
+    for (int k = 0; k < rc_size; ++k) {
+      const int a_ik = a[(i * rc_size) + k];
+      const int *b_row = b + (static_cast<ptrdiff_t>(k) * rc_size);
+      for (int j = 0; j < rc_size; ++j) {
+        out_row[j] += a_ik * b_row[j];
+      }
+    }
+  }
+}
+
+}  // namespace
+
 bool nesterov_a_test_task_mpi::TestTaskMPI::PreProcessingImpl() {
   // Init value for input and output
-  unsigned int input_size = task_data->inputs_count[0];
-  auto *in_ptr = reinterpret_cast<int *>(task_data->inputs[0]);
-  input_ = std::vector<int>(in_ptr, in_ptr + input_size);
+  if (world_.rank() == 0) {
+    const auto input = task_data->Input<int>(0);
+    input_.assign(input.begin(), input.end());
+
+    const size_t output_size = task_data->Output<int>(0).size();
+    output_ = std::vector<int>(output_size, 0);
+
+    rc_size_ = static_cast<int>(std::sqrt(input.size()));
+  }
+  boost::mpi::broadcast(world_, rc_size_, 0);
 
-  unsigned int output_size = task_data->outputs_count[0];
-  output_ = std::vector<int>(output_size, 0);
+  // Split rows into almost equal contiguous blocks
+  const int num_procs = world_.size();
+  block_sizes_.assign(num_procs, 0);
+  block_displs_.assign(num_procs, 0);
+  for (int proc = 0, displ = 0; proc < num_procs; proc++) {
+    const int num_rows = (rc_size_ / num_procs) + (proc < rc_size_ % num_procs ? 1 : 0);
+    block_sizes_[proc] = num_rows * rc_size_;
+    block_displs_[proc] = displ;
+    displ += block_sizes_[proc];
+  }
 
-  rc_size_ = static_cast<int>(std::sqrt(input_size));
+  // Buffers are allocated once, so runs only communicate and compute
+  const int local_size = block_sizes_[world_.rank()];
+  local_input_.assign(local_size, 0);
+  local_output_.assign(local_size, 0);
+  if (world_.rank() != 0) {
+    right_matrix_.assign(static_cast<size_t>(rc_size_) * rc_size_, 0);
+  }
   return true;
 }
 
 bool nesterov_a_test_task_mpi::TestTaskMPI::ValidationImpl() {
-  // Check equality of counts elements
-  return task_data->inputs_count[0] == task_data->outputs_count[0];
+  // Check equality of counts elements on the root, all ranks get the same answer
+  bool is_valid = true;
+  if (world_.rank() == 0) {
+    is_valid = task_data->Input<int>(0).size() == task_data->Output<int>(0).size();
+  }
+  boost::mpi::broadcast(world_, is_valid, 0);
+  return is_valid;
 }
 
 bool nesterov_a_test_task_mpi::TestTaskMPI::RunImpl() {
+  const int local_size = block_sizes_[world_.rank()];
+  int *right_matrix = world_.rank() == 0 ? input_.data() : right_matrix_.data();
+
   if (world_.rank() == 0) {
-    // Multiply matrices
-    for (int i = 0; i < rc_size_; ++i) {
-      for (int j = 0; j < rc_size_; ++j) {
-        for (int k = 0; k < rc_size_; ++k) {
-          output_[(i * rc_size_) + j] += input_[(i * rc_size_) + k] * input_[(k * rc_size_) + j];
-        }
-      }
-    }
+    boost::mpi::scatterv(world_, input_.data(), block_sizes_, block_displs_, local_input_.data(), local_size, 0);
   } else {
-    // Multiply matrices
-    for (int j = 0; j < rc_size_; ++j) {
-      for (int k = 0; k < rc_size_; ++k) {
-        for (int i = 0; i < rc_size_; ++i) {
-          output_[(i * rc_size_) + j] += input_[(i * rc_size_) + k] * input_[(k * rc_size_) + j];
-        }
-      }
-    }
+    boost::mpi::scatterv(world_, local_input_.data(), local_size, 0);
+  }
+  boost::mpi::broadcast(world_, right_matrix, rc_size_ * rc_size_, 0);
+
+  MatMulRows(local_input_, right_matrix, rc_size_, local_size / std::max(rc_size_, 1), local_output_);
+
+  if (world_.rank() == 0) {
+    boost::mpi::gatherv(world_, local_output_.data(), local_size, output_.data(), block_sizes_, block_displs_, 0);
+  } else {
+    boost::mpi::gatherv(world_, local_output_.data(), local_size, 0);
   }
-  world_.barrier();
   return true;
 }
 
 bool nesterov_a_test_task_mpi::TestTaskMPI::PostProcessingImpl() {
-  for (size_t i = 0; i < output_.size(); i++) {
-    reinterpret_cast<int *>(task_data->outputs[0])[i] = output_[i];
+  if (world_.rank() == 0) {
+    std::ranges::copy(output_, task_data->Output<int>(0).begin());
   }
   return true;
 }
@@ -71,3 +71,41 @@ TEST(nesterov_a_test_task_omp, test_matmul_100_from_file) {
   test_task_omp.PostProcessing();
   EXPECT_EQ(in, out);
 }
+
+TEST(nesterov_a_test_task_omp, test_matmul_schedules) {
+  constexpr size_t kCount = 150;
+
+  // Create data
+  std::vector<int> in(kCount * kCount, 0);
+  std::vector<int> expected(kCount * kCount, 0);
+  for (size_t i = 0; i < in.size(); i++) {
+    in[i] = static_cast<int>((i * 7) % 11) - 5;
+  }
+  for (size_t i = 0; i < kCount; i++) {
+    for (size_t j = 0; j < kCount; j++) {
+      for (size_t k = 0; k < kCount; k++) {
+        expected[(i * kCount) + j] += in[(i * kCount) + k] * in[(k * kCount) + j];
+      }
+    }
+  }
+
+  for (auto schedule : {nesterov_a_test_task_omp::Schedule::kStatic, nesterov_a_test_task_omp::Schedule::kDynamic,
+                        nesterov_a_test_task_omp::Schedule::kGuided}) {
+    std::vector<int> out(kCount * kCount, 0);
+
+    // Create task_data
+    auto task_data_omp = std::make_shared<ppc::core::TaskData>();
+    task_data_omp->inputs.emplace_back(reinterpret_cast<uint8_t *>(in.data()));
+    task_data_omp->inputs_count.emplace_back(in.size());
+    task_data_omp->outputs.emplace_back(reinterpret_cast<uint8_t *>(out.data()));
+    task_data_omp->outputs_count.emplace_back(out.size());
+
+    // Create Task
+    nesterov_a_test_task_omp::TestTaskOpenMP test_task_omp(task_data_omp, schedule);
+    ASSERT_EQ(test_task_omp.Validation(), true);
+    test_task_omp.PreProcessing();
+    test_task_omp.Run();
+    test_task_omp.PostProcessing();
+    EXPECT_EQ(expected, out);
+  }
+}
@@ -1,23 +1,30 @@
 #pragma once
 
+#include <cstdint>
 #include <utility>
 #include <vector>
 
 #include "core/task/include/task.hpp"
+#include "core/util/include/numa.hpp"
 
 namespace nesterov_a_test_task_omp {
 
+// OpenMP schedule of output tiles between threads
+enum class Schedule : uint8_t { kStatic, kDynamic, kGuided };
+
 class TestTaskOpenMP : public ppc::core::Task {
  public:
-  explicit TestTaskOpenMP(ppc::core::TaskDataPtr task_data) : Task(std::move(task_data)) {}
+  explicit TestTaskOpenMP(ppc::core::TaskDataPtr task_data, Schedule schedule = Schedule::kStatic)
+      : Task(std::move(task_data)), schedule_(schedule) {}
   bool PreProcessingImpl() override;
   bool ValidationImpl() override;
   bool RunImpl() override;
   bool PostProcessingImpl() override;
 
  private:
-  std::vector<int> input_, output_;
+  Schedule schedule_;
+  ppc::util::FirstTouchVector<int> input_, output_;
   int rc_size_{};
 };
 
-}  // namespace nesterov_a_test_task_omp
\ No newline at end of file
+}  // namespace nesterov_a_test_task_omp
@@ -1,93 +1,28 @@
 #include <gtest/gtest.h>
 
-#include <chrono>
 #include <cstddef>
-#include <cstdint>
-#include <memory>
 #include <vector>
 
-#include "core/perf/include/perf.hpp"
-#include "core/task/include/task.hpp"
+#include "core/perf/include/perf_test.hpp"
 #include "omp/example/include/ops_omp.hpp"
 
-TEST(nesterov_a_test_task_omp, test_pipeline_run) {
-  constexpr int kCount = 300;
-
-  // Create data
-  std::vector<int> in(kCount * kCount, 0);
-  std::vector<int> out(kCount * kCount, 0);
-
-  for (size_t i = 0; i < kCount; i++) {
-    in[(i * kCount) + i] = 1;
-  }
-
-  // Create task_data
-  auto task_data_omp = std::make_shared<ppc::core::TaskData>();
-  task_data_omp->inputs.emplace_back(reinterpret_cast<uint8_t *>(in.data()));
-  task_data_omp->inputs_count.emplace_back(in.size());
-  task_data_omp->outputs.emplace_back(reinterpret_cast<uint8_t *>(out.data()));
-  task_data_omp->outputs_count.emplace_back(out.size());
-
-  // Create Task
-  auto test_task_omp = std::make_shared<nesterov_a_test_task_omp::TestTaskOpenMP>(task_data_omp);
-
-  // Create Perf attributes
-  auto perf_attr = std::make_shared<ppc::core::PerfAttr>();
-  perf_attr->num_running = 10;
-  const auto t0 = std::chrono::high_resolution_clock::now();
-  perf_attr->current_timer = [&] {
-    auto current_time_point = std::chrono::high_resolution_clock::now();
-    auto duration = std::chrono::duration_cast<std::chrono::nanoseconds>(current_time_point - t0).count();
-    return static_cast<double>(duration) * 1e-9;
+namespace {
+
+ppc::core::PerfTestCase<nesterov_a_test_task_omp::TestTaskOpenMP, int> MakeTestCase() {
+  ppc::core::PerfTestCase<nesterov_a_test_task_omp::TestTaskOpenMP, int> test_case;
+  test_case.sizes = {300};
+  test_case.work_exponent = 3.0;
+  test_case.generate = [](size_t count) {
+    std::vector<int> in(count * count, 0);
+    for (size_t i = 0; i < count; i++) {
+      in[(i * count) + i] = 1;
+    }
+    return in;
   };
-
-  // Create and init perf results
-  auto perf_results = std::make_shared<ppc::core::PerfResults>();
-
-  // Create Perf analyzer
-  auto perf_analyzer = std::make_shared<ppc::core::Perf>(test_task_omp);
-  perf_analyzer->PipelineRun(perf_attr, perf_results);
-  ppc::core::Perf::PrintPerfStatistic(perf_results);
-  ASSERT_EQ(in, out);
+  test_case.check = [](const std::vector<int> &in, const std::vector<int> &out) { return in == out; };
+  return test_case;
 }
 
-TEST(nesterov_a_test_task_omp, test_task_run) {
-  constexpr int kCount = 300;
-
-  // Create data
-  std::vector<int> in(kCount * kCount, 0);
-  std::vector<int> out(kCount * kCount, 0);
+}  // namespace
 
-  for (size_t i = 0; i < kCount; i++) {
-    in[(i * kCount) + i] = 1;
-  }
-
-  // Create task_data
-  auto task_data_omp = std::make_shared<ppc::core::TaskData>();
-  task_data_omp->inputs.emplace_back(reinterpret_cast<uint8_t *>(in.data()));
-  task_data_omp->inputs_count.emplace_back(in.size());
-  task_data_omp->outputs.emplace_back(reinterpret_cast<uint8_t *>(out.data()));
-  task_data_omp->outputs_count.emplace_back(out.size());
-
-  // Create Task
-  auto test_task_omp = std::make_shared<nesterov_a_test_task_omp::TestTaskOpenMP>(task_data_omp);
-
-  // Create Perf attributes
-  auto perf_attr = std::make_shared<ppc::core::PerfAttr>();
-  perf_attr->num_running = 10;
-  const auto t0 = std::chrono::high_resolution_clock::now();
-  perf_attr->current_timer = [&] {
-    auto current_time_point = std::chrono::high_resolution_clock::now();
-    auto duration = std::chrono::duration_cast<std::chrono::nanoseconds>(current_time_point - t0).count();
-    return static_cast<double>(duration) * 1e-9;
-  };
-
-  // Create and init perf results
-  auto perf_results = std::make_shared<ppc::core::PerfResults>();
-
-  // Create Perf analyzer
-  auto perf_analyzer = std::make_shared<ppc::core::Perf>(test_task_omp);
-  perf_analyzer->TaskRun(perf_attr, perf_results);
-  ppc::core::Perf::PrintPerfStatistic(perf_results);
-  ASSERT_EQ(in, out);
-}
+PPC_PERF_TESTS(nesterov_a_test_task_omp, MakeTestCase)
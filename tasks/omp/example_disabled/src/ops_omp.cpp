@@ -1,49 +1,130 @@
 #include "omp/example/include/ops_omp.hpp"
 
+#include <omp.h>
+
+#include <algorithm>
 #include <cmath>
 #include <cstddef>
 #include <vector>
 
+#include "core/util/include/numa.hpp"
+#include "core/util/include/topology.hpp"
+#include "core/util/include/util.hpp"
+
+namespace {
+
+// Side of square output tiles, a tile of the result and a slice of a row of
+// the right matrix stay in L1 while the tile is computed
+constexpr int kTileSize = 64;
+
+// Computes tile of out = in * in which starts at (row_begin, col_begin)
+void MatMulTile(const ppc::util::FirstTouchVector<int> &in, int rc_size, int row_begin, int col_begin,
+                ppc::util::FirstTouchVector<int> &out) {
+  const int row_end = std::min(row_begin + kTileSize, rc_size);
+  const int col_end = std::min(col_begin + kTileSize, rc_size);
+  for (int i = row_begin; i < row_end; ++i) {
+    int *out_row = out.data() + (static_cast<ptrdiff_t>(i) * rc_size);
+    std::fill(out_row + col_begin, out_row + col_end, 0);
+    for (int k = 0; k < rc_size; ++k) {
+      const int a_ik = in[(i * rc_size) + k];
+      const int *in_row = in.data() + (static_cast<ptrdiff_t>(k) * rc_size);
+      for (int j = col_begin; j < col_end; ++j) {
+        out_row[j] += a_ik * in_row[j];
+      }
+    }
+  }
+}
+
+}  // namespace
+
 bool nesterov_a_test_task_omp::TestTaskOpenMP::PreProcessingImpl() {
   // Init value for input and output
-  unsigned int input_size = task_data->inputs_count[0];
-  auto *in_ptr = reinterpret_cast<int *>(task_data->inputs[0]);
-  input_ = std::vector<int>(in_ptr, in_ptr + input_size);
+  const auto input = task_data->Input<int>(0);
+  const size_t input_size = input.size();
+  const int *in_ptr = input.data();
+  rc_size_ = static_cast<int>(std::sqrt(input_size));
 
-  unsigned int output_size = task_data->outputs_count[0];
-  output_ = std::vector<int>(output_size, 0);
+  // Threads of the team are bound by their numbers once per PreProcessing(), so
+  // Run() has no syscalls, runtimes keep threads of a team of the same size for
+  // later regions. The calling thread gets its mask back after the region, so
+  // threads created later by the process don't inherit the binding, and runs its
+  // share of Run() unbound. Binding set by OMP_PLACES and OMP_PROC_BIND is kept.
+  const auto pinning = ppc::util::GetPPCPinning();
+  const bool pin = pinning.IsActive() && omp_get_proc_bind() == omp_proc_bind_false;
+  const auto caller_cpus = pin ? ppc::util::CurrentThreadCpus() : std::vector<int>{};
 
-  rc_size_ = static_cast<int>(std::sqrt(input_size));
+  // Rows are touched first with the static split of rows between threads, so
+  // pages land on NUMA nodes of threads which compute the same rows. Output
+  // tiles are zeroed by Run().
+  if (input_.size() != input_size) {
+    input_ = ppc::util::FirstTouchVector<int>(input_size);
+  }
+#pragma omp parallel num_threads(ppc::util::GetPPCNumThreads())
+  {
+    if (pin) {
+      static_cast<void>(pinning.Pin(omp_get_thread_num()));
+    }
+#pragma omp for schedule(static)
+    for (int i = 0; i < rc_size_; ++i) {
+      std::copy(in_ptr + (static_cast<ptrdiff_t>(i) * rc_size_), in_ptr + (static_cast<ptrdiff_t>(i + 1) * rc_size_),
+                input_.begin() + (static_cast<ptrdiff_t>(i) * rc_size_));
+    }
+  }
+  if (pin) {
+    static_cast<void>(ppc::util::PinCurrentThread(caller_cpus));
+  }
+
+  const size_t output_size = task_data->Output<int>(0).size();
+  if (output_.size() != output_size) {
+    output_ = ppc::util::FirstTouchVector<int>(output_size);
+  }
   return true;
 }
 
 bool nesterov_a_test_task_omp::TestTaskOpenMP::ValidationImpl() {
   // Check equality of counts elements
-  return task_data->inputs_count[0] == task_data->outputs_count[0];
+  return task_data->Input<int>(0).size() == task_data->Output<int>(0).size();
 }
 
 bool nesterov_a_test_task_omp::TestTaskOpenMP::RunImpl() {
-#pragma omp parallel default(none)
+  const int num_tiles = (rc_size_ + kTileSize - 1) / kTileSize;
+
+  // Every tile of the output is computed by one thread, so threads never write
+  // to the same elements. The schedule is a clause of the loop, so run-sched-var
+  // of the process isn't changed and every kind keeps its default chunk
+#pragma omp parallel num_threads(ppc::util::GetPPCNumThreads())
   {
-#pragma omp critical
-    {
-      // Multiply matrices
-      for (int i = 0; i < rc_size_; ++i) {
-        for (int j = 0; j < rc_size_; ++j) {
-          output_[(i * rc_size_) + j] = 0;
-          for (int k = 0; k < rc_size_; ++k) {
-            output_[(i * rc_size_) + j] += input_[(i * rc_size_) + k] * input_[(k * rc_size_) + j];
+    switch (schedule_) {
+      case Schedule::kStatic:
+#pragma omp for collapse(2) schedule(static)
+        for (int tile_i = 0; tile_i < num_tiles; ++tile_i) {
+          for (int tile_j = 0; tile_j < num_tiles; ++tile_j) {
+            MatMulTile(input_, rc_size_, tile_i * kTileSize, tile_j * kTileSize, output_);
           }
         }
-      }
+        break;
+      case Schedule::kDynamic:
+#pragma omp for collapse(2) schedule(dynamic)
+        for (int tile_i = 0; tile_i < num_tiles; ++tile_i) {
+          for (int tile_j = 0; tile_j < num_tiles; ++tile_j) {
+            MatMulTile(input_, rc_size_, tile_i * kTileSize, tile_j * kTileSize, output_);
+          }
+        }
+        break;
+      case Schedule::kGuided:
+#pragma omp for collapse(2) schedule(guided)
+        for (int tile_i = 0; tile_i < num_tiles; ++tile_i) {
+          for (int tile_j = 0; tile_j < num_tiles; ++tile_j) {
+            MatMulTile(input_, rc_size_, tile_i * kTileSize, tile_j * kTileSize, output_);
+          }
+        }
+        break;
     }
   }
   return true;
 }
 
 bool nesterov_a_test_task_omp::TestTaskOpenMP::PostProcessingImpl() {
-  for (size_t i = 0; i < output_.size(); i++) {
-    reinterpret_cast<int *>(task_data->outputs[0])[i] = output_[i];
-  }
+  std::ranges::copy(output_, task_data->Output<int>(0).begin());
   return true;
 }
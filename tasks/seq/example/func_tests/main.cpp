@@ -5,6 +5,7 @@
 #include <fstream>
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "core/task/include/task.hpp"
@@ -71,3 +72,63 @@ TEST(nesterov_a_test_task_seq, test_matmul_100_from_file) {
   test_task_sequential.PostProcessing();
   EXPECT_EQ(in, out);
 }
+
+TEST(nesterov_a_test_task_seq, test_matmul_variants_match) {
+  // Sizes cover partial register blocks and several depth blocks
+  for (size_t count : {1, 7, 37, 300}) {
+    // Create data
+    std::vector<int> in(count * count, 0);
+    std::vector<int> out_naive(count * count, 0);
+    std::vector<int> out_blocked(count * count, 0);
+    for (size_t i = 0; i < in.size(); i++) {
+      in[i] = static_cast<int>((i * 7) % 11) - 5;
+    }
+
+    for (auto [variant, out] : {std::pair{nesterov_a_test_task_seq::Variant::kNaive, &out_naive},
+                                std::pair{nesterov_a_test_task_seq::Variant::kBlocked, &out_blocked}}) {
+      // Create task_data
+      auto task_data_seq = std::make_shared<ppc::core::TaskData>();
+      task_data_seq->inputs.emplace_back(reinterpret_cast<uint8_t *>(in.data()));
+      task_data_seq->inputs_count.emplace_back(in.size());
+      task_data_seq->outputs.emplace_back(reinterpret_cast<uint8_t *>(out->data()));
+      task_data_seq->outputs_count.emplace_back(out->size());
+
+      // Create Task
+      nesterov_a_test_task_seq::TestTaskSequential test_task_sequential(task_data_seq, variant);
+      ASSERT_EQ(test_task_sequential.Validation(), true);
+      test_task_sequential.PreProcessing();
+      test_task_sequential.Run();
+      test_task_sequential.PostProcessing();
+    }
+    EXPECT_EQ(out_naive, out_blocked) << "count = " << count;
+  }
+}
+
+TEST(nesterov_a_test_task_seq, test_matmul_repeated_run) {
+  constexpr size_t kCount = 20;
+
+  // Create data
+  std::vector<int> in(kCount * kCount, 0);
+  std::vector<int> out(kCount * kCount, 0);
+  for (size_t i = 0; i < kCount; i++) {
+    in[(i * kCount) + i] = 1;
+  }
+
+  for (auto variant : {nesterov_a_test_task_seq::Variant::kNaive, nesterov_a_test_task_seq::Variant::kBlocked}) {
+    // Create task_data
+    auto task_data_seq = std::make_shared<ppc::core::TaskData>();
+    task_data_seq->inputs.emplace_back(reinterpret_cast<uint8_t *>(in.data()));
+    task_data_seq->inputs_count.emplace_back(in.size());
+    task_data_seq->outputs.emplace_back(reinterpret_cast<uint8_t *>(out.data()));
+    task_data_seq->outputs_count.emplace_back(out.size());
+
+    // Every Run() computes the product from scratch, as Perf::TaskRun repeats it
+    nesterov_a_test_task_seq::TestTaskSequential test_task_sequential(task_data_seq, variant);
+    ASSERT_EQ(test_task_sequential.Validation(), true);
+    test_task_sequential.PreProcessing();
+    test_task_sequential.Run();
+    test_task_sequential.Run();
+    test_task_sequential.PostProcessing();
+    EXPECT_EQ(in, out);
+  }
+}
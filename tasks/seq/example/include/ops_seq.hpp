@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <utility>
 #include <vector>
 
@@ -7,17 +8,24 @@
 
 namespace nesterov_a_test_task_seq {
 
+// Kernel of matrix multiplication: kNaive is the plain i-j-k loop, kBlocked
+// packs panels of the right matrix and multiplies them by a cache-blocked,
+// register-blocked kernel
+enum class Variant : uint8_t { kNaive, kBlocked };
+
 class TestTaskSequential : public ppc::core::Task {
  public:
-  explicit TestTaskSequential(ppc::core::TaskDataPtr task_data) : Task(std::move(task_data)) {}
+  explicit TestTaskSequential(ppc::core::TaskDataPtr task_data, Variant variant = Variant::kBlocked)
+      : Task(std::move(task_data)), variant_(variant) {}
   bool PreProcessingImpl() override;
   bool ValidationImpl() override;
   bool RunImpl() override;
   bool PostProcessingImpl() override;
 
  private:
+  Variant variant_;
   std::vector<int> input_, output_;
   int rc_size_{};
 };
 
-}  // namespace nesterov_a_test_task_seq
\ No newline at end of file
+}  // namespace nesterov_a_test_task_seq
@@ -1,42 +1,128 @@
 #include "seq/example/include/ops_seq.hpp"
 
+#include <algorithm>
+#include <array>
 #include <cmath>
 #include <cstddef>
+#include <span>
 #include <vector>
 
+namespace {
+
+// Sizes of the register block (kMr x kNr elements of the result), of the
+// depth block which keeps packed panels in L1/L2 and of the column block
+constexpr int kMr = 4;
+constexpr int kNr = 16;
+constexpr int kKc = 256;
+constexpr int kNc = 512;
+
+void MatMulNaive(const std::vector<int> &in, int rc_size, std::vector<int> &out) {
+  std::ranges::fill(out, 0);
+  for (int i = 0; i < rc_size; ++i) {
+    for (int j = 0; j < rc_size; ++j) {
+      for (int k = 0; k < rc_size; ++k) {
+        out[(i * rc_size) + j] += in[(i * rc_size) + k] * in[(k * rc_size) + j];
+      }
+    }
+  }
+}
+
+// Copies block [k0, k0 + kc) x [j0, j0 + nc) of b into panels of kNr columns,
+// every panel is stored row by row, missing columns are padded with zeros
+void PackPanels(const int *b, int ldb, int k0, int kc, int j0, int nc, int *packed) {
+  for (int jr = 0; jr < nc; jr += kNr) {
+    const int nr = std::min(kNr, nc - jr);
+    for (int k = 0; k < kc; ++k) {
+      const int *src = b + (static_cast<ptrdiff_t>(k0 + k) * ldb) + j0 + jr;
+      std::copy(src, src + nr, packed);
+      std::fill(packed + nr, packed + kNr, 0);
+      packed += kNr;
+    }
+  }
+}
+
+// c[0:mr, 0:nr] += a[0:mr, 0:kc] * panel, rows past mr repeat the last one, so
+// the loops always have constant bounds and are fully vectorized
+void MicroKernel(const int *a, int lda, const int *panel, int kc, int *c, int ldc, int mr, int nr) {
+  std::array<const int *, kMr> rows{};
+  for (int i = 0; i < kMr; ++i) {
+    rows[i] = a + (static_cast<ptrdiff_t>(std::min(i, mr - 1)) * lda);
+  }
+
+  std::array<std::array<int, kNr>, kMr> acc{};
+  for (int k = 0; k < kc; ++k) {
+    const int *b = panel + (static_cast<ptrdiff_t>(k) * kNr);
+    for (int i = 0; i < kMr; ++i) {
+      const int a_ik = rows[i][k];
+      for (int j = 0; j < kNr; ++j) {
+        acc[i][j] += a_ik * b[j];
+      }
+    }
+  }
+
+  for (int i = 0; i < mr; ++i) {
+    for (int j = 0; j < nr; ++j) {
+      c[(static_cast<ptrdiff_t>(i) * ldc) + j] += acc[i][j];
+    }
+  }
+}
+
+void MatMulBlocked(const std::vector<int> &in, int rc_size, std::span<int> packed, std::vector<int> &out) {
+  std::ranges::fill(out, 0);
+  const int *a = in.data();
+  const int *b = in.data();
+  int *c = out.data();
+  for (int j0 = 0; j0 < rc_size; j0 += kNc) {
+    const int nc = std::min(kNc, rc_size - j0);
+    for (int k0 = 0; k0 < rc_size; k0 += kKc) {
+      const int kc = std::min(kKc, rc_size - k0);
+      PackPanels(b, rc_size, k0, kc, j0, nc, packed.data());
+      for (int i0 = 0; i0 < rc_size; i0 += kMr) {
+        const int mr = std::min(kMr, rc_size - i0);
+        for (int jr = 0; jr < nc; jr += kNr) {
+          const int *panel = packed.data() + (static_cast<ptrdiff_t>(jr) * kc);
+          MicroKernel(a + (static_cast<ptrdiff_t>(i0) * rc_size) + k0, rc_size, panel, kc,
+                      c + (static_cast<ptrdiff_t>(i0) * rc_size) + j0 + jr, rc_size, mr, std::min(kNr, nc - jr));
+        }
+      }
+    }
+  }
+}
+
+}  // namespace
+
 bool nesterov_a_test_task_seq::TestTaskSequential::PreProcessingImpl() {
   // Init value for input and output
-  unsigned int input_size = task_data->inputs_count[0];
-  auto *in_ptr = reinterpret_cast<int *>(task_data->inputs[0]);
-  input_ = std::vector<int>(in_ptr, in_ptr + input_size);
+  const auto input = task_data->Input<int>(0);
+  input_.assign(input.begin(), input.end());
 
-  unsigned int output_size = task_data->outputs_count[0];
+  const size_t output_size = task_data->Output<int>(0).size();
   output_ = std::vector<int>(output_size, 0);
 
-  rc_size_ = static_cast<int>(std::sqrt(input_size));
+  rc_size_ = static_cast<int>(std::sqrt(input.size()));
   return true;
 }
 
 bool nesterov_a_test_task_seq::TestTaskSequential::ValidationImpl() {
   // Check equality of counts elements
-  return task_data->inputs_count[0] == task_data->outputs_count[0];
+  return task_data->Input<int>(0).size() == task_data->Output<int>(0).size();
 }
 
 bool nesterov_a_test_task_seq::TestTaskSequential::RunImpl() {
   // Multiply matrices
-  for (int i = 0; i < rc_size_; ++i) {
-    for (int j = 0; j < rc_size_; ++j) {
-      for (int k = 0; k < rc_size_; ++k) {
-        output_[(i * rc_size_) + j] += input_[(i * rc_size_) + k] * input_[(k * rc_size_) + j];
-      }
-    }
+  if (variant_ == Variant::kBlocked) {
+    // Packed panels live in the scratch arena of the task, after the first run
+    // it serves them without heap allocations
+    const int panels_width = (std::min(kNc, rc_size_) + kNr - 1) / kNr * kNr;
+    auto packed = Scratch().Allocate<int>(static_cast<size_t>(std::min(kKc, rc_size_)) * panels_width);
+    MatMulBlocked(input_, rc_size_, packed, output_);
+  } else {
+    MatMulNaive(input_, rc_size_, output_);
   }
   return true;
 }
 
 bool nesterov_a_test_task_seq::TestTaskSequential::PostProcessingImpl() {
-  for (size_t i = 0; i < output_.size(); i++) {
-    reinterpret_cast<int *>(task_data->outputs[0])[i] = output_[i];
-  }
+  std::ranges::copy(output_, task_data->Output<int>(0).begin());
   return true;
 }
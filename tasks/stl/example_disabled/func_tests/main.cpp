@@ -1,13 +1,18 @@
 #include <gtest/gtest.h>
 
+#include <algorithm>
 #include <cstddef>
 #include <cstdint>
 #include <fstream>
 #include <memory>
+#include <mutex>
+#include <set>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include "core/task/include/task.hpp"
+#include "core/thread_pool/include/thread_pool.hpp"
 #include "core/util/include/util.hpp"
 #include "stl/example/include/ops_stl.hpp"
 
@@ -71,3 +76,57 @@ TEST(nesterov_a_test_task_stl, test_matmul_100_from_file) {
   test_task_stl.PostProcessing();
   EXPECT_EQ(in, out);
 }
+
+TEST(nesterov_a_test_task_stl, test_matmul_thread_pool_reused) {
+  constexpr size_t kCount = 45;
+
+  // Create data
+  std::vector<int> in(kCount * kCount, 0);
+  std::vector<int> out(kCount * kCount, 0);
+  std::vector<int> expected(kCount * kCount, 0);
+  for (size_t i = 0; i < in.size(); i++) {
+    in[i] = static_cast<int>((i * 7) % 11) - 5;
+  }
+  for (size_t i = 0; i < kCount; i++) {
+    for (size_t j = 0; j < kCount; j++) {
+      for (size_t k = 0; k < kCount; k++) {
+        expected[(i * kCount) + j] += in[(i * kCount) + k] * in[(k * kCount) + j];
+      }
+    }
+  }
+
+  // Threads which run chunks of loops of the global pool
+  auto &pool = ppc::core::ThreadPool::Global();
+  std::mutex thread_ids_mutex;
+  std::set<std::thread::id> thread_ids;
+  auto collect_thread_ids = [&] {
+    pool.ParallelFor(0, 1000, [&](size_t, size_t) {
+      std::lock_guard lock(thread_ids_mutex);
+      thread_ids.insert(std::this_thread::get_id());
+    });
+  };
+
+  // Create task_data
+  auto task_data_stl = std::make_shared<ppc::core::TaskData>();
+  task_data_stl->inputs.emplace_back(reinterpret_cast<uint8_t *>(in.data()));
+  task_data_stl->inputs_count.emplace_back(in.size());
+  task_data_stl->outputs.emplace_back(reinterpret_cast<uint8_t *>(out.data()));
+  task_data_stl->outputs_count.emplace_back(out.size());
+
+  // Create Task, both cycles run on the same pool of the process
+  nesterov_a_test_task_stl::TestTaskSTL test_task_stl(task_data_stl);
+  collect_thread_ids();
+  for (int cycle = 0; cycle < 2; cycle++) {
+    ASSERT_EQ(test_task_stl.Validation(), true);
+    test_task_stl.PreProcessing();
+    test_task_stl.Run();
+    test_task_stl.Run();
+    test_task_stl.PostProcessing();
+    EXPECT_EQ(expected, out);
+    collect_thread_ids();
+  }
+
+  EXPECT_EQ(&pool, &ppc::core::ThreadPool::Global());
+  EXPECT_EQ(pool.Size(), std::max(ppc::util::GetPPCNumThreads(), 1));
+  EXPECT_LE(thread_ids.size(), static_cast<size_t>(pool.Size()));
+}
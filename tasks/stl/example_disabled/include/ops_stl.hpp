@@ -4,6 +4,7 @@
 #include <vector>
 
 #include "core/task/include/task.hpp"
+#include "core/util/include/numa.hpp"
 
 namespace nesterov_a_test_task_stl {
 
@@ -16,7 +17,7 @@ class TestTaskSTL : public ppc::core::Task {
   bool PostProcessingImpl() override;
 
  private:
-  std::vector<int> input_, output_;
+  ppc::util::FirstTouchVector<int> input_, output_;
   int rc_size_{};
 };
 
@@ -1,56 +1,83 @@
 #include "stl/example/include/ops_stl.hpp"
 
+#include <algorithm>
 #include <cmath>
 #include <cstddef>
-#include <thread>
 #include <vector>
 
-#include "core/util/include/util.hpp"
+#include "core/thread_pool/include/thread_pool.hpp"
+#include "core/util/include/numa.hpp"
 
 namespace {
-void MatMul(const std::vector<int> &in_vec, int rc_size, std::vector<int> &out_vec) {
-  for (int i = 0; i < rc_size; ++i) {
-    for (int j = 0; j < rc_size; ++j) {
-      out_vec[(i * rc_size) + j] = 0;
-      for (int k = 0; k < rc_size; ++k) {
-        out_vec[(i * rc_size) + j] += in_vec[(i * rc_size) + k] * in_vec[(k * rc_size) + j];
+
+// Number of rows in a chunk of work, small enough to balance threads and big
+// enough to make taking a chunk negligible
+constexpr size_t kRowsPerChunk = 8;
+
+// Rows [row_begin, row_end) of out = in * in, the i-k-j order walks rows of
+// both matrices contiguously, so the inner loop is vectorized
+void MatMulRows(const ppc::util::FirstTouchVector<int> &in, int rc_size, int row_begin, int row_end,
+                ppc::util::FirstTouchVector<int> &out) {
+  for (int i = row_begin; i < row_end; ++i) {
+    int *out_row = out.data() + (static_cast<ptrdiff_t>(i) * rc_size);
+    std::fill(out_row, out_row + rc_size, 0);
+    for (int k = 0; k < rc_size; ++k) {
+      const int a_ik = in[(i * rc_size) + k];
+      const int *in_row = in.data() + (static_cast<ptrdiff_t>(k) * rc_size);
+      for (int j = 0; j < rc_size; ++j) {
+        out_row[j] += a_ik * in_row[j];
       }
     }
   }
 }
+
 }  // namespace
 
 bool nesterov_a_test_task_stl::TestTaskSTL::PreProcessingImpl() {
   // Init value for input and output
-  unsigned int input_size = task_data->inputs_count[0];
-  auto *in_ptr = reinterpret_cast<int *>(task_data->inputs[0]);
-  input_ = std::vector<int>(in_ptr, in_ptr + input_size);
+  const auto input = task_data->Input<int>(0);
+  const size_t input_size = input.size();
+  const int *in_ptr = input.data();
+  rc_size_ = static_cast<int>(std::sqrt(input_size));
 
-  unsigned int output_size = task_data->outputs_count[0];
-  output_ = std::vector<int>(output_size, 0);
+  // Buffers are touched first by the threads which process their rows, so
+  // pages land on NUMA nodes of these threads. Output rows are zeroed by Run().
+  if (input_.size() != input_size) {
+    input_ = ppc::util::FirstTouchVector<int>(input_size);
+  }
+  const auto row_size = static_cast<size_t>(rc_size_);
+  ppc::core::ThreadPool::Global().ParallelFor(
+      0, row_size,
+      [&](size_t row_begin, size_t row_end) {
+        std::copy(in_ptr + (row_begin * row_size), in_ptr + (row_end * row_size),
+                  input_.begin() + static_cast<ptrdiff_t>(row_begin * row_size));
+      },
+      kRowsPerChunk);
 
-  rc_size_ = static_cast<int>(std::sqrt(input_size));
+  const size_t output_size = task_data->Output<int>(0).size();
+  if (output_.size() != output_size) {
+    output_ = ppc::util::FirstTouchVector<int>(output_size);
+  }
   return true;
 }
 
 bool nesterov_a_test_task_stl::TestTaskSTL::ValidationImpl() {
   // Check equality of counts elements
-  return task_data->inputs_count[0] == task_data->outputs_count[0];
+  return task_data->Input<int>(0).size() == task_data->Output<int>(0).size();
 }
 
 bool nesterov_a_test_task_stl::TestTaskSTL::RunImpl() {
-  const int num_threads = ppc::util::GetPPCNumThreads();
-  std::vector<std::thread> threads(num_threads);
-  for (int i = 0; i < num_threads; i++) {
-    threads[i] = std::thread(MatMul, std::cref(input_), rc_size_, std::ref(output_));
-    threads[i].join();
-  }
+  // Threads of the process-wide pool are created once and reused by every Run()
+  ppc::core::ThreadPool::Global().ParallelFor(
+      0, rc_size_,
+      [this](size_t row_begin, size_t row_end) {
+        MatMulRows(input_, rc_size_, static_cast<int>(row_begin), static_cast<int>(row_end), output_);
+      },
+      kRowsPerChunk);
   return true;
 }
 
 bool nesterov_a_test_task_stl::TestTaskSTL::PostProcessingImpl() {
-  for (size_t i = 0; i < output_.size(); i++) {
-    reinterpret_cast<int *>(task_data->outputs[0])[i] = output_[i];
-  }
+  std::ranges::copy(output_, task_data->Output<int>(0).begin());
   return true;
 }
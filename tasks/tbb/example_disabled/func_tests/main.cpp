@@ -71,3 +71,45 @@ TEST(nesterov_a_test_task_tbb, test_matmul_100_from_file) {
   test_task_tbb.PostProcessing();
   EXPECT_EQ(in, out);
 }
+
+TEST(nesterov_a_test_task_tbb, test_matmul_partitioners) {
+  constexpr size_t kCount = 150;
+
+  // Create data
+  std::vector<int> in(kCount * kCount, 0);
+  std::vector<int> expected(kCount * kCount, 0);
+  for (size_t i = 0; i < in.size(); i++) {
+    in[i] = static_cast<int>((i * 7) % 11) - 5;
+  }
+  for (size_t i = 0; i < kCount; i++) {
+    for (size_t j = 0; j < kCount; j++) {
+      for (size_t k = 0; k < kCount; k++) {
+        expected[(i * kCount) + j] += in[(i * kCount) + k] * in[(k * kCount) + j];
+      }
+    }
+  }
+
+  for (auto partitioner :
+       {nesterov_a_test_task_tbb::Partitioner::kAuto, nesterov_a_test_task_tbb::Partitioner::kAffinity,
+        nesterov_a_test_task_tbb::Partitioner::kStatic}) {
+    std::vector<int> out(kCount * kCount, 0);
+
+    // Create task_data
+    auto task_data_tbb = std::make_shared<ppc::core::TaskData>();
+    task_data_tbb->inputs.emplace_back(reinterpret_cast<uint8_t *>(in.data()));
+    task_data_tbb->inputs_count.emplace_back(in.size());
+    task_data_tbb->outputs.emplace_back(reinterpret_cast<uint8_t *>(out.data()));
+    task_data_tbb->outputs_count.emplace_back(out.size());
+
+    // Create Task, the second cycle reuses the arena of the first one
+    nesterov_a_test_task_tbb::TestTaskTBB test_task_tbb(task_data_tbb, partitioner);
+    for (int cycle = 0; cycle < 2; cycle++) {
+      ASSERT_EQ(test_task_tbb.Validation(), true);
+      test_task_tbb.PreProcessing();
+      test_task_tbb.Run();
+      test_task_tbb.Run();
+      test_task_tbb.PostProcessing();
+      EXPECT_EQ(expected, out);
+    }
+  }
+}
@@ -1,23 +1,72 @@
 #pragma once
 
+#include <oneapi/tbb/partitioner.h>
+#include <oneapi/tbb/task_arena.h>
+#include <oneapi/tbb/task_scheduler_observer.h>
+
+#include <cstdint>
+#include <memory>
 #include <utility>
 #include <vector>
 
 #include "core/task/include/task.hpp"
+#include "core/util/include/numa.hpp"
+#include "core/util/include/topology.hpp"
 
 namespace nesterov_a_test_task_tbb {
 
+// Partitioner of output tiles between TBB workers
+enum class Partitioner : uint8_t { kAuto, kAffinity, kStatic };
+
+// Binds threads entering the arena like threads of other runtimes, the slot of
+// a thread in the arena is its index in the pinning. Every thread gets its mask
+// back on leaving the arena, so the external thread in slot 0 and threads created
+// by it later aren't left bound. Constraints of task_arena select only a NUMA
+// node or a core type, so they can't express compact and scatter placement.
+class ArenaPinning : public oneapi::tbb::task_scheduler_observer {
+ public:
+  ArenaPinning(oneapi::tbb::task_arena &arena, ppc::util::Pinning pinning)
+      : task_scheduler_observer(arena), pinning_(std::move(pinning)) {
+    observe(true);
+  }
+  ArenaPinning(const ArenaPinning &) = delete;
+  ArenaPinning &operator=(const ArenaPinning &) = delete;
+  ~ArenaPinning() override { observe(false); }
+
+  void on_scheduler_entry(bool /*is_worker*/) override {
+    SavedCpus() = ppc::util::CurrentThreadCpus();
+    static_cast<void>(pinning_.Pin(oneapi::tbb::this_task_arena::current_thread_index()));
+  }
+  void on_scheduler_exit(bool /*is_worker*/) override {
+    static_cast<void>(ppc::util::PinCurrentThread(SavedCpus()));
+  }
+
+ private:
+  ppc::util::Pinning pinning_;
+
+  // Mask of the calling thread before it entered the arena
+  static std::vector<int> &SavedCpus() {
+    thread_local std::vector<int> cpus;
+    return cpus;
+  }
+};
+
 class TestTaskTBB : public ppc::core::Task {
  public:
-  explicit TestTaskTBB(ppc::core::TaskDataPtr task_data) : Task(std::move(task_data)) {}
+  explicit TestTaskTBB(ppc::core::TaskDataPtr task_data, Partitioner partitioner = Partitioner::kAuto)
+      : Task(std::move(task_data)), partitioner_(partitioner) {}
   bool PreProcessingImpl() override;
   bool ValidationImpl() override;
   bool RunImpl() override;
   bool PostProcessingImpl() override;
 
  private:
-  std::vector<int> input_, output_;
+  Partitioner partitioner_;
+  ppc::util::FirstTouchVector<int> input_, output_;
   int rc_size_{};
+  std::unique_ptr<oneapi::tbb::task_arena> arena_;
+  std::unique_ptr<ArenaPinning> arena_pinning_;
+  oneapi::tbb::affinity_partitioner affinity_partitioner_;
 };
 
 }  // namespace nesterov_a_test_task_tbb
@@ -1,61 +1,115 @@
 #include "tbb/example/include/ops_tbb.hpp"
 
-#include <tbb/tbb.h>
+#include <oneapi/tbb/blocked_range.h>
+#include <oneapi/tbb/blocked_range2d.h>
+#include <oneapi/tbb/parallel_for.h>
+#include <oneapi/tbb/partitioner.h>
+#include <oneapi/tbb/task_arena.h>
 
+#include <algorithm>
 #include <cmath>
-#include <core/util/include/util.hpp>
 #include <cstddef>
+#include <memory>
+#include <utility>
 #include <vector>
 
-#include "oneapi/tbb/task_arena.h"
-#include "oneapi/tbb/task_group.h"
+#include "core/util/include/numa.hpp"
+#include "core/util/include/topology.hpp"
+#include "core/util/include/util.hpp"
 
 namespace {
-void MatMul(const std::vector<int> &in_vec, int rc_size, std::vector<int> &out_vec) {
-  for (int i = 0; i < rc_size; ++i) {
-    for (int j = 0; j < rc_size; ++j) {
-      out_vec[(i * rc_size) + j] = 0;
-      for (int k = 0; k < rc_size; ++k) {
-        out_vec[(i * rc_size) + j] += in_vec[(i * rc_size) + k] * in_vec[(k * rc_size) + j];
+
+// Grain of tiles in both dimensions, a tile of the result and a slice of a
+// row of the right matrix stay in L1 while the tile is computed
+constexpr int kTileSize = 64;
+
+// Computes block [rows] x [cols] of out = in * in
+void MatMulTile(const ppc::util::FirstTouchVector<int> &in, int rc_size, const oneapi::tbb::blocked_range2d<int> &tile,
+                ppc::util::FirstTouchVector<int> &out) {
+  const int col_begin = tile.cols().begin();
+  const int col_end = tile.cols().end();
+  for (int i = tile.rows().begin(); i < tile.rows().end(); ++i) {
+    int *out_row = out.data() + (static_cast<ptrdiff_t>(i) * rc_size);
+    std::fill(out_row + col_begin, out_row + col_end, 0);
+    for (int k = 0; k < rc_size; ++k) {
+      const int a_ik = in[(i * rc_size) + k];
+      const int *in_row = in.data() + (static_cast<ptrdiff_t>(k) * rc_size);
+      for (int j = col_begin; j < col_end; ++j) {
+        out_row[j] += a_ik * in_row[j];
       }
     }
   }
 }
+
 }  // namespace
 
 bool nesterov_a_test_task_tbb::TestTaskTBB::PreProcessingImpl() {
   // Init value for input and output
-  unsigned int input_size = task_data->inputs_count[0];
-  auto *in_ptr = reinterpret_cast<int *>(task_data->inputs[0]);
-  input_ = std::vector<int>(in_ptr, in_ptr + input_size);
+  const auto input = task_data->Input<int>(0);
+  const size_t input_size = input.size();
+  const int *in_ptr = input.data();
+  rc_size_ = static_cast<int>(std::sqrt(input_size));
+
+  // The arena is kept between runs, it is recreated only if the number of threads changes
+  const int num_threads = std::max(ppc::util::GetPPCNumThreads(), 1);
+  if (!arena_ || arena_->max_concurrency() != num_threads) {
+    arena_pinning_.reset();
+    arena_ = std::make_unique<oneapi::tbb::task_arena>(num_threads);
+    arena_->initialize();
+    auto pinning = ppc::util::GetPPCPinning();
+    if (pinning.IsActive()) {
+      arena_pinning_ = std::make_unique<ArenaPinning>(*arena_, std::move(pinning));
+    }
+  }
 
-  unsigned int output_size = task_data->outputs_count[0];
-  output_ = std::vector<int>(output_size, 0);
+  // Rows are touched first by threads of the arena, so pages land on their
+  // NUMA nodes. Output tiles are zeroed by Run().
+  if (input_.size() != input_size) {
+    input_ = ppc::util::FirstTouchVector<int>(input_size);
+  }
+  arena_->execute([&] {
+    oneapi::tbb::parallel_for(
+        oneapi::tbb::blocked_range<int>(0, rc_size_, kTileSize),
+        [&](const oneapi::tbb::blocked_range<int> &rows) {
+          std::copy(in_ptr + (static_cast<ptrdiff_t>(rows.begin()) * rc_size_),
+                    in_ptr + (static_cast<ptrdiff_t>(rows.end()) * rc_size_),
+                    input_.begin() + (static_cast<ptrdiff_t>(rows.begin()) * rc_size_));
+        },
+        oneapi::tbb::static_partitioner());
+  });
 
-  rc_size_ = static_cast<int>(std::sqrt(input_size));
+  const size_t output_size = task_data->Output<int>(0).size();
+  if (output_.size() != output_size) {
+    output_ = ppc::util::FirstTouchVector<int>(output_size);
+  }
   return true;
 }
 
 bool nesterov_a_test_task_tbb::TestTaskTBB::ValidationImpl() {
   // Check equality of counts elements
-  return task_data->inputs_count[0] == task_data->outputs_count[0];
+  return task_data->Input<int>(0).size() == task_data->Output<int>(0).size();
 }
 
 bool nesterov_a_test_task_tbb::TestTaskTBB::RunImpl() {
-  oneapi::tbb::task_arena arena(1);
-  arena.execute([&] {
-    tbb::task_group tg;
-    for (int thr = 0; thr < ppc::util::GetPPCNumThreads(); ++thr) {
-      tg.run([&] { MatMul(input_, rc_size_, output_); });
+  const oneapi::tbb::blocked_range2d<int> range(0, rc_size_, kTileSize, 0, rc_size_, kTileSize);
+  auto body = [&](const oneapi::tbb::blocked_range2d<int> &tile) { MatMulTile(input_, rc_size_, tile, output_); };
+  arena_->execute([&] {
+    switch (partitioner_) {
+      case Partitioner::kAffinity:
+        oneapi::tbb::parallel_for(range, body, affinity_partitioner_);
+        break;
+      case Partitioner::kStatic:
+        oneapi::tbb::parallel_for(range, body, oneapi::tbb::static_partitioner());
+        break;
+      case Partitioner::kAuto:
+        oneapi::tbb::parallel_for(range, body, oneapi::tbb::auto_partitioner());
+        break;
     }
-    tg.wait();
   });
   return true;
 }
 
 bool nesterov_a_test_task_tbb::TestTaskTBB::PostProcessingImpl() {
-  for (size_t i = 0; i < output_.size(); i++) {
-    reinterpret_cast<int *>(task_data->outputs[0])[i] = output_[i];
-  }
+  std::ranges::copy(output_, task_data->Output<int>(0).begin());
   return true;
 }